@@ -0,0 +1,211 @@
+"""NumPy bindings for the cipher evaluation engine (the cipherc shared library).
+
+Words are NumPy arrays of fixed-width byte strings (dtype 'S<len>', uppercase
+A-Z) or uint8 arrays of shape (n, len); contiguous inputs are handed to the
+library as they are and results are written straight into NumPy arrays, so
+nothing is copied on the Python side. Patterns are uint16 base-3 codes: tile
+i adds state * 3**i with absent 0, present 1, correct 2, exactly as in the
+game.
+
+    import cipher
+    words = cipher.Words.load("assets/words.txt", 5)
+    pats = words.evaluate("CRANE")                 # uint16[n]
+    table = words.matrix(words.array)              # uint16[n, n]
+    left = words.array[words.filter("CRANE", pats[0])]
+
+The library is looked up in $CIPHER_LIB, next to this file, then in build/
+and _gate_build/ of the repository.
+"""
+import ctypes
+import ctypes.util
+import os
+
+import numpy as np
+
+__all__ = ["Words", "score", "encode", "decode", "isa", "MAX_LENGTH"]
+
+MAX_LENGTH = 6
+_ABI_VERSION = 1
+
+
+def _find_library():
+    names = ["libcipherc.so", "libcipherc.dylib", "cipherc.dll"]
+    here = os.path.dirname(os.path.abspath(__file__))
+    root = os.path.dirname(here)
+    candidates = []
+    if os.environ.get("CIPHER_LIB"):
+        candidates.append(os.environ["CIPHER_LIB"])
+    for d in (here, os.path.join(root, "build"), os.path.join(root, "_gate_build")):
+        candidates += [os.path.join(d, n) for n in names]
+    for path in candidates:
+        if os.path.exists(path):
+            return path
+    found = ctypes.util.find_library("cipherc")
+    if found:
+        return found
+    raise OSError("cipherc shared library not found; build it or set CIPHER_LIB")
+
+
+_lib = ctypes.CDLL(_find_library())
+
+_u8p = ctypes.POINTER(ctypes.c_uint8)
+_u16p = ctypes.POINTER(ctypes.c_uint16)
+_words_p = ctypes.c_void_p
+
+_lib.cipher_abi_version.restype = ctypes.c_int
+_lib.cipher_isa.restype = ctypes.c_char_p
+_lib.cipher_words_new.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_int]
+_lib.cipher_words_new.restype = _words_p
+_lib.cipher_words_load.argtypes = [ctypes.c_char_p, ctypes.c_int]
+_lib.cipher_words_load.restype = _words_p
+_lib.cipher_words_free.argtypes = [_words_p]
+_lib.cipher_words_count.argtypes = [_words_p]
+_lib.cipher_words_count.restype = ctypes.c_size_t
+_lib.cipher_words_length.argtypes = [_words_p]
+_lib.cipher_words_length.restype = ctypes.c_int
+_lib.cipher_words_data.argtypes = [_words_p]
+_lib.cipher_words_data.restype = ctypes.c_void_p
+_lib.cipher_score.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_int]
+_lib.cipher_score.restype = ctypes.c_int
+_lib.cipher_evaluate.argtypes = [_words_p, ctypes.c_void_p, _u16p]
+_lib.cipher_evaluate.restype = ctypes.c_int
+_lib.cipher_evaluate_many.argtypes = [_words_p, ctypes.c_void_p, ctypes.c_size_t, _u16p, ctypes.c_int]
+_lib.cipher_evaluate_many.restype = ctypes.c_int
+_lib.cipher_filter.argtypes = [_words_p, ctypes.c_void_p, ctypes.c_uint16, _u8p]
+_lib.cipher_filter.restype = ctypes.c_long
+_lib.cipher_pattern_encode.argtypes = [_u8p, ctypes.c_int]
+_lib.cipher_pattern_encode.restype = ctypes.c_uint16
+_lib.cipher_pattern_decode.argtypes = [ctypes.c_uint16, ctypes.c_int, _u8p]
+
+if _lib.cipher_abi_version() != _ABI_VERSION:
+    raise OSError("cipherc ABI version %d, expected %d" % (_lib.cipher_abi_version(), _ABI_VERSION))
+
+
+def _packed(words, length=None):
+    """C-contiguous uint8 view (n, len) of `words`; copies only when the input
+    is a Python list or a non-contiguous / differently typed array."""
+    if isinstance(words, (str, bytes)):
+        words = [words]
+    if not isinstance(words, np.ndarray):
+        words = np.array([w.upper().encode() if isinstance(w, str) else w for w in words],
+                         dtype="S%d" % length if length else None)
+    if words.dtype.kind == "S":
+        n = words.dtype.itemsize
+        words = np.ascontiguousarray(words).view(np.uint8).reshape(-1, n)
+    elif words.dtype != np.uint8 or words.ndim != 2:
+        raise TypeError("words must be an 'S<len>' array or uint8 array of shape (n, len)")
+    words = np.ascontiguousarray(words)
+    if length is not None and words.shape[1] != length:
+        raise ValueError("expected %d-letter words, got %d" % (length, words.shape[1]))
+    return words
+
+
+def _guess(guess, length):
+    g = guess.upper().encode() if isinstance(guess, str) else bytes(guess)
+    if len(g) != length:
+        raise ValueError("guess %r is not %d letters" % (guess, length))
+    return g
+
+
+class Words:
+    """An answer list prepared for batch scoring."""
+
+    def __init__(self, words, length=None):
+        packed = _packed(words, length)
+        n, length = packed.shape
+        self._h = _lib.cipher_words_new(packed.ctypes.data, n, length)
+        if not self._h:
+            raise ValueError("words must be %d..%d uppercase letters A-Z" % (1, MAX_LENGTH))
+
+    @classmethod
+    def load(cls, path, length):
+        """Words of `length` letters from a word list file (sorted, unique)."""
+        self = cls.__new__(cls)
+        self._h = _lib.cipher_words_load(os.fsencode(path), length)
+        if not self._h:
+            raise ValueError("bad word length %d" % length)
+        return self
+
+    def __del__(self):
+        h, self._h = getattr(self, "_h", None), None
+        if h:
+            _lib.cipher_words_free(h)
+
+    def __len__(self):
+        return _lib.cipher_words_count(self._h)
+
+    @property
+    def length(self):
+        return _lib.cipher_words_length(self._h)
+
+    @property
+    def array(self):
+        """The words as a read-only 'S<len>' array over the library's buffer."""
+        n, length = len(self), self.length
+        if n == 0:
+            return np.empty(0, dtype="S%d" % length)
+        buf = (ctypes.c_char * (n * length)).from_address(_lib.cipher_words_data(self._h))
+        buf.owner = self  # the view keeps `buf`, `buf` keeps the handle
+        a = np.frombuffer(buf, dtype="S%d" % length)
+        a.flags.writeable = False
+        return a
+
+    def evaluate(self, guess, out=None):
+        """uint16[n]: pattern of `guess` against every word."""
+        g = _guess(guess, self.length)
+        out = self._out(out, (len(self),), np.uint16)
+        if _lib.cipher_evaluate(self._h, g, out.ctypes.data_as(_u16p)) != 0:
+            raise ValueError("guess %r must be uppercase letters A-Z" % (guess,))
+        return out
+
+    def matrix(self, guesses, threads=0, out=None):
+        """uint16[g, n]: every guess against every word, on `threads` cores (0 = all)."""
+        packed = _packed(guesses, self.length)
+        out = self._out(out, (packed.shape[0], len(self)), np.uint16)
+        if _lib.cipher_evaluate_many(self._h, packed.ctypes.data, packed.shape[0],
+                                     out.ctypes.data_as(_u16p), threads) != 0:
+            raise ValueError("guesses must be uppercase letters A-Z")
+        return out
+
+    def filter(self, guess, pattern, out=None):
+        """bool[n]: words that would show `pattern` for `guess`."""
+        g = _guess(guess, self.length)
+        out = self._out(out, (len(self),), np.bool_)
+        if _lib.cipher_filter(self._h, g, int(pattern), out.view(np.uint8).ctypes.data_as(_u8p)) < 0:
+            raise ValueError("guess %r must be uppercase letters A-Z" % (guess,))
+        return out
+
+    @staticmethod
+    def _out(out, shape, dtype):
+        if out is None:
+            return np.empty(shape, dtype=dtype)
+        if out.shape != shape or out.dtype != dtype or not out.flags.c_contiguous:
+            raise ValueError("out must be a contiguous %s array of shape %s" % (np.dtype(dtype).name, shape))
+        return out
+
+
+def score(secret, guess):
+    """Pattern shown for `guess` when `secret` is the answer."""
+    s, g = _guess(secret, len(secret)), _guess(guess, len(secret))
+    p = _lib.cipher_score(s, g, len(s))
+    if p < 0:
+        raise ValueError("words must be 1..%d uppercase letters A-Z" % MAX_LENGTH)
+    return p
+
+
+def encode(states):
+    """Pattern for a sequence of tile states (0 absent, 1 present, 2 correct)."""
+    a = np.ascontiguousarray(states, dtype=np.uint8)
+    return _lib.cipher_pattern_encode(a.ctypes.data_as(_u8p), len(a))
+
+
+def decode(pattern, length):
+    """uint8[length] tile states of `pattern`."""
+    out = np.empty(length, dtype=np.uint8)
+    _lib.cipher_pattern_decode(int(pattern), length, out.ctypes.data_as(_u8p))
+    return out
+
+
+def isa():
+    """SIMD kernel the library dispatches to."""
+    return _lib.cipher_isa().decode()
@@ -0,0 +1,25 @@
+#include "AllocCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> g_allocs{0};
+
+    void* countedAlloc(size_t n) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(n ? n : 1)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(size_t n) { return countedAlloc(n); }
+void* operator new[](size_t n) { return countedAlloc(n); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+uint64_t AllocCounter::count() {
+    return g_allocs.load(std::memory_order_relaxed);
+}
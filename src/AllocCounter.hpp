@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+// Global operator new/delete replaced with a counting malloc/free. Linked
+// (as the cipher_alloc object library) only into executables that measure
+// allocations: cipher-bench and the GUI targets, whose FrameProfiler reads it.
+namespace AllocCounter {
+    uint64_t count(); // operator new calls since startup
+}
@@ -0,0 +1,151 @@
+#include "BatchEval.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#if defined(CIPHER_X86_KERNELS) && defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+void LetterColumns::assign(const Dictionary& dict) {
+    assign(dict.data(), dict.size(), dict.length());
+}
+
+void LetterColumns::assign(const char* words, size_t count, int len) {
+    m_count = count;
+    m_len = len;
+    m_stride = (count + kPad - 1) / kPad * kPad;
+    if (m_stride == 0) m_stride = kPad;
+    // padding never matches a guess letter (0..25)
+    m_letters.assign(m_stride * len, 31);
+    for (size_t i=0; i<count; ++i)
+        for (int p=0; p<len; ++p)
+            m_letters[p * m_stride + i] = (uint8_t)(words[i * len + p] - 'A');
+}
+
+namespace {
+    // Len = 0: length only known at run time
+    template <int Len>
+    void scalarLoop(const uint8_t* const* cols, size_t n, int len,
+                    const char* guess, uint8_t* out8, uint16_t* out16) {
+        if constexpr (Len > 0) len = Len;
+        char word[Patterns::kMaxLength];
+        for (size_t i=0; i<n; ++i) {
+            for (int p=0; p<len; ++p) word[p] = (char)('A' + cols[p][i]);
+            Pattern pat;
+            if constexpr (Len > 0) pat = Patterns::score<Len>(word, guess);
+            else pat = Patterns::score(word, guess, len);
+            if (out8) out8[i] = (uint8_t)pat; else out16[i] = pat;
+        }
+    }
+}
+
+void BatchEval::detail::evalScalar(const uint8_t* const* cols, size_t n, int len,
+                                   const char* guess, uint8_t* out8, uint16_t* out16) {
+    switch (len) {
+    case 4: scalarLoop<4>(cols, n, len, guess, out8, out16); break;
+    case 5: scalarLoop<5>(cols, n, len, guess, out8, out16); break;
+    case 6: scalarLoop<6>(cols, n, len, guess, out8, out16); break;
+    default: scalarLoop<0>(cols, n, len, guess, out8, out16); break;
+    }
+}
+
+void BatchEval::detail::distScalar(const uint8_t* const* cols, size_t n, int len,
+                                   const char* word, uint8_t* out) {
+    for (size_t i=0; i<n; ++i) {
+        uint8_t d = 0;
+        for (int p=0; p<len; ++p) d += cols[p][i] != (uint8_t)(word[p] - 'A');
+        out[i] = d;
+    }
+}
+
+namespace {
+    std::atomic<int> g_forced{-1};
+
+#if defined(CIPHER_X86_KERNELS)
+    bool cpuHas(BatchEval::Isa isa) {
+#  if defined(_MSC_VER)
+        int r[4];
+        __cpuid(r, 1);
+        bool sse42 = (r[2] & (1 << 20)) != 0;
+        bool osxsave = (r[2] & (1 << 27)) != 0;
+        if (isa == BatchEval::Isa::SSE42) return sse42;
+        if (!osxsave || (_xgetbv(0) & 6) != 6) return false; // OS saves YMM state
+        __cpuidex(r, 7, 0);
+        return (r[1] & (1 << 5)) != 0;
+#  else
+        __builtin_cpu_init();
+        if (isa == BatchEval::Isa::SSE42) return __builtin_cpu_supports("sse4.2");
+        return __builtin_cpu_supports("avx2");
+#  endif
+    }
+#endif
+
+    BatchEval::detail::Kernel kernelFor(BatchEval::Isa isa) {
+        switch (isa) {
+#if defined(CIPHER_X86_KERNELS)
+        case BatchEval::Isa::AVX2:  return BatchEval::detail::evalAVX2;
+        case BatchEval::Isa::SSE42: return BatchEval::detail::evalSSE42;
+#endif
+        default:                    return BatchEval::detail::evalScalar;
+        }
+    }
+
+    BatchEval::detail::DistanceKernel distanceKernelFor(BatchEval::Isa isa) {
+        switch (isa) {
+#if defined(CIPHER_X86_KERNELS)
+        case BatchEval::Isa::AVX2:  return BatchEval::detail::distAVX2;
+        case BatchEval::Isa::SSE42: return BatchEval::detail::distSSE42;
+#endif
+        default:                    return BatchEval::detail::distScalar;
+        }
+    }
+
+    void run(const char* guess, const LetterColumns& cands, uint8_t* out8, uint16_t* out16) {
+        const uint8_t* cols[Patterns::kMaxLength];
+        for (int p=0; p<cands.length(); ++p) cols[p] = cands.column(p);
+        kernelFor(BatchEval::active())(cols, cands.size(), cands.length(), guess, out8, out16);
+    }
+}
+
+BatchEval::Isa BatchEval::detect() {
+#if defined(CIPHER_X86_KERNELS)
+    static const Isa best = cpuHas(Isa::AVX2) ? Isa::AVX2
+                          : cpuHas(Isa::SSE42) ? Isa::SSE42 : Isa::Scalar;
+    return best;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+BatchEval::Isa BatchEval::active() {
+    int f = g_forced.load(std::memory_order_relaxed);
+    return f < 0 ? detect() : (Isa)f;
+}
+
+void BatchEval::force(Isa isa) {
+    g_forced = (int)std::min(isa, detect());
+}
+
+const char* BatchEval::name(Isa isa) {
+    switch (isa) {
+    case Isa::AVX2:  return "avx2";
+    case Isa::SSE42: return "sse4.2";
+    default:         return "scalar";
+    }
+}
+
+void BatchEval::evaluate(const char* guess, const LetterColumns& cands, Pattern* out) {
+    run(guess, cands, nullptr, out);
+}
+
+void BatchEval::evaluate(const char* guess, const LetterColumns& cands, uint8_t* out) {
+    assert(Patterns::cellBytes(cands.length()) == 1);
+    run(guess, cands, out, nullptr);
+}
+
+void BatchEval::distances(const char* word, const LetterColumns& cands, uint8_t* out) {
+    const uint8_t* cols[Patterns::kMaxLength];
+    for (int p=0; p<cands.length(); ++p) cols[p] = cands.column(p);
+    distanceKernelFor(active())(cols, cands.size(), cands.length(), word, out);
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Dictionary.hpp"
+#include "Pattern.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Candidate words stored column-wise: column(p)[i] is letter p of word i
+// as 0..25. Columns are padded to a multiple of 32 so SIMD kernels can
+// load whole registers past the end.
+class LetterColumns {
+public:
+    static constexpr size_t kPad = 32;
+
+    LetterColumns() = default;
+    explicit LetterColumns(const Dictionary& dict) { assign(dict); }
+
+    void assign(const Dictionary& dict);
+    // `words` holds `count` words of `len` letters back to back
+    void assign(const char* words, size_t count, int len);
+
+    size_t size() const { return m_count; }
+    int length() const { return m_len; }
+    const uint8_t* column(int p) const { return m_letters.data() + p * m_stride; }
+
+private:
+    std::vector<uint8_t> m_letters; // m_len columns of m_stride bytes
+    size_t m_stride = 0;
+    size_t m_count = 0;
+    int m_len = 0;
+};
+
+// Scores one guess against every word in a LetterColumns at once. Results
+// are bit-identical to Patterns::score(candidate, guess, len).
+namespace BatchEval {
+    enum class Isa { Scalar, SSE42, AVX2 };
+
+    Isa detect();              // best kernel this CPU and build support
+    Isa active();              // kernel evaluate() currently dispatches to
+    void force(Isa isa);       // clamped to detect(); for benchmarks
+    const char* name(Isa isa);
+
+    void evaluate(const char* guess, const LetterColumns& cands, Pattern* out);
+    // Byte-wide patterns; lengths up to 5 only.
+    void evaluate(const char* guess, const LetterColumns& cands, uint8_t* out);
+    // Hamming distance from `word` to every candidate: positions whose
+    // letters differ, one byte each.
+    void distances(const char* word, const LetterColumns& cands, uint8_t* out);
+
+    namespace detail {
+        using Kernel = void (*)(const uint8_t* const* cols, size_t n, int len,
+                                const char* guess, uint8_t* out8, uint16_t* out16);
+        void evalScalar(const uint8_t* const* cols, size_t n, int len,
+                        const char* guess, uint8_t* out8, uint16_t* out16);
+        void evalSSE42(const uint8_t* const* cols, size_t n, int len,
+                       const char* guess, uint8_t* out8, uint16_t* out16);
+        void evalAVX2(const uint8_t* const* cols, size_t n, int len,
+                      const char* guess, uint8_t* out8, uint16_t* out16);
+
+        using DistanceKernel = void (*)(const uint8_t* const* cols, size_t n, int len,
+                                        const char* word, uint8_t* out);
+        void distScalar(const uint8_t* const* cols, size_t n, int len, const char* word, uint8_t* out);
+        void distSSE42(const uint8_t* const* cols, size_t n, int len, const char* word, uint8_t* out);
+        void distAVX2(const uint8_t* const* cols, size_t n, int len, const char* word, uint8_t* out);
+    }
+}
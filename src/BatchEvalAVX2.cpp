@@ -0,0 +1,37 @@
+// Built with -mavx2 (or /arch:AVX2); only called after BatchEval::detect()
+// has seen AVX2 at runtime.
+#include "BatchEval.hpp"
+#include "BatchEvalSimd.hpp"
+#include <immintrin.h>
+
+namespace {
+    struct Avx2 {
+        using Vec = __m256i;
+        static constexpr size_t kLanes = 32;
+        static Vec load(const uint8_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+        static Vec zero() { return _mm256_setzero_si256(); }
+        static Vec ones() { return _mm256_set1_epi8(-1); }
+        static Vec set1_8(uint8_t v) { return _mm256_set1_epi8((char)v); }
+        static Vec set1_16(uint16_t v) { return _mm256_set1_epi16((short)v); }
+        static Vec eq8(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+        static Vec cmpgt8(Vec a, Vec b) { return _mm256_cmpgt_epi8(a, b); }
+        static Vec and_(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+        static Vec andnot(Vec a, Vec b) { return _mm256_andnot_si256(a, b); } // ~a & b
+        static Vec add8(Vec a, Vec b) { return _mm256_add_epi8(a, b); }
+        static Vec add16(Vec a, Vec b) { return _mm256_add_epi16(a, b); }
+        static Vec widenLo(Vec a) { return _mm256_cvtepi8_epi16(_mm256_castsi256_si128(a)); }
+        static Vec widenHi(Vec a) { return _mm256_cvtepi8_epi16(_mm256_extracti128_si256(a, 1)); }
+        static void store8(uint8_t* p, Vec a) { _mm256_storeu_si256((__m256i*)p, a); }
+        static void store16(uint16_t* p, Vec a) { _mm256_storeu_si256((__m256i*)p, a); }
+    };
+}
+
+void BatchEval::detail::evalAVX2(const uint8_t* const* cols, size_t n, int len,
+                                 const char* guess, uint8_t* out8, uint16_t* out16) {
+    batchKernel<Avx2>(cols, n, len, guess, out8, out16);
+}
+
+void BatchEval::detail::distAVX2(const uint8_t* const* cols, size_t n, int len,
+                                 const char* word, uint8_t* out) {
+    distanceKernel<Avx2>(cols, n, len, word, out);
+}
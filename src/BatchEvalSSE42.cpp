@@ -0,0 +1,37 @@
+// Built with -msse4.2; only called after BatchEval::detect() has seen
+// SSE4.2 at runtime.
+#include "BatchEval.hpp"
+#include "BatchEvalSimd.hpp"
+#include <nmmintrin.h>
+
+namespace {
+    struct Sse42 {
+        using Vec = __m128i;
+        static constexpr size_t kLanes = 16;
+        static Vec load(const uint8_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+        static Vec zero() { return _mm_setzero_si128(); }
+        static Vec ones() { return _mm_set1_epi8(-1); }
+        static Vec set1_8(uint8_t v) { return _mm_set1_epi8((char)v); }
+        static Vec set1_16(uint16_t v) { return _mm_set1_epi16((short)v); }
+        static Vec eq8(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+        static Vec cmpgt8(Vec a, Vec b) { return _mm_cmpgt_epi8(a, b); }
+        static Vec and_(Vec a, Vec b) { return _mm_and_si128(a, b); }
+        static Vec andnot(Vec a, Vec b) { return _mm_andnot_si128(a, b); } // ~a & b
+        static Vec add8(Vec a, Vec b) { return _mm_add_epi8(a, b); }
+        static Vec add16(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+        static Vec widenLo(Vec a) { return _mm_cvtepi8_epi16(a); }
+        static Vec widenHi(Vec a) { return _mm_cvtepi8_epi16(_mm_srli_si128(a, 8)); }
+        static void store8(uint8_t* p, Vec a) { _mm_storeu_si128((__m128i*)p, a); }
+        static void store16(uint16_t* p, Vec a) { _mm_storeu_si128((__m128i*)p, a); }
+    };
+}
+
+void BatchEval::detail::evalSSE42(const uint8_t* const* cols, size_t n, int len,
+                                  const char* guess, uint8_t* out8, uint16_t* out16) {
+    batchKernel<Sse42>(cols, n, len, guess, out8, out16);
+}
+
+void BatchEval::detail::distSSE42(const uint8_t* const* cols, size_t n, int len,
+                                  const char* word, uint8_t* out) {
+    distanceKernel<Sse42>(cols, n, len, word, out);
+}
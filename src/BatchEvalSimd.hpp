@@ -0,0 +1,99 @@
+#pragma once
+// Shared bodies of the SSE4.2 and AVX2 batch kernels. Included only by the
+// per-ISA translation units; V wraps the intrinsics of one instruction set.
+//
+// Per candidate, with green[k] = (s[k] == g[k]):
+//   avail(i) = #{k : s[k] == g[i] && !green[k]}
+//   used(i)  = #{j < i : g[j] == g[i] && !green[j]}
+//   yellow(i) = !green[i] && avail(i) > used(i)
+// which is exactly the two-pass count logic of Patterns::score. Masks are
+// 0 / -1 bytes, so counts are accumulated as negative numbers.
+#include "Pattern.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+template <class V>
+void batchKernel(const uint8_t* const* cols, size_t n, int len,
+                 const char* guess, uint8_t* out8, uint16_t* out16) {
+    using Vec = typename V::Vec;
+    constexpr size_t W = V::kLanes;
+    constexpr int kMax = Patterns::kMaxLength;
+    static constexpr uint16_t pow3[kMax] = {1, 3, 9, 27, 81, 243};
+
+    Vec g[kMax];
+    unsigned prev[kMax] = {0}; // earlier guess positions with the same letter
+    for (int i=0;i<len;++i) {
+        g[i] = V::set1_8((uint8_t)(guess[i] - 'A'));
+        for (int j=0;j<i;++j) if (guess[j] == guess[i]) prev[i] |= 1u << j;
+    }
+    const Vec zero = V::zero();
+    const Vec ones = V::ones();
+
+    alignas(64) uint8_t tail8[W];
+    alignas(64) uint16_t tail16[W];
+
+    for (size_t base = 0; base < n; base += W) {
+        Vec s[kMax], green[kMax], open[kMax];
+        for (int k=0;k<len;++k) {
+            s[k] = V::load(cols[k] + base);
+            green[k] = V::eq8(s[k], g[k]);
+            open[k] = V::andnot(green[k], ones);
+        }
+        Vec yellow[kMax];
+        for (int i=0;i<len;++i) {
+            Vec avail = zero;
+            for (int k=0;k<len;++k) avail = V::add8(avail, V::and_(V::eq8(s[k], g[i]), open[k]));
+            Vec used = zero;
+            for (int j=0;j<i;++j) if (prev[i] & (1u << j)) used = V::add8(used, open[j]);
+            yellow[i] = V::and_(open[i], V::cmpgt8(used, avail));
+        }
+
+        const bool full = base + W <= n;
+        if (out8) {
+            Vec code = zero;
+            for (int i=0;i<len;++i) {
+                code = V::add8(code, V::and_(green[i], V::set1_8((uint8_t)(2 * pow3[i]))));
+                code = V::add8(code, V::and_(yellow[i], V::set1_8((uint8_t)pow3[i])));
+            }
+            V::store8(full ? out8 + base : tail8, code);
+            if (!full) std::memcpy(out8 + base, tail8, n - base);
+        } else {
+            Vec lo = zero, hi = zero;
+            for (int i=0;i<len;++i) {
+                Vec c2 = V::set1_16((uint16_t)(2 * pow3[i]));
+                Vec c1 = V::set1_16(pow3[i]);
+                lo = V::add16(lo, V::and_(V::widenLo(green[i]), c2));
+                hi = V::add16(hi, V::and_(V::widenHi(green[i]), c2));
+                lo = V::add16(lo, V::and_(V::widenLo(yellow[i]), c1));
+                hi = V::add16(hi, V::and_(V::widenHi(yellow[i]), c1));
+            }
+            uint16_t* dst = full ? out16 + base : tail16;
+            V::store16(dst, lo);
+            V::store16(dst + W / 2, hi);
+            if (!full) std::memcpy(out16 + base, tail16, (n - base) * sizeof(uint16_t));
+        }
+    }
+}
+
+// Hamming distance: len plus one -1 mask per matching position.
+template <class V>
+void distanceKernel(const uint8_t* const* cols, size_t n, int len, const char* word, uint8_t* out) {
+    using Vec = typename V::Vec;
+    constexpr size_t W = V::kLanes;
+    Vec w[Patterns::kMaxLength];
+    for (int p=0;p<len;++p) w[p] = V::set1_8((uint8_t)(word[p] - 'A'));
+    const Vec start = V::set1_8((uint8_t)len);
+
+    alignas(64) uint8_t tail[W];
+    for (size_t base = 0; base < n; base += W) {
+        Vec d = start;
+        for (int p=0;p<len;++p) d = V::add8(d, V::eq8(V::load(cols[p] + base), w[p]));
+        if (base + W <= n) {
+            V::store8(out + base, d);
+        } else {
+            V::store8(tail, d);
+            std::memcpy(out + base, tail, n - base);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "CandidateSet.hpp"
+
+void CandidateSet::reset(size_t n) {
+    m_size = n;
+    m_count = n;
+    m_bits.assign((n + 63) / 64, ~0ull);
+    if (n % 64) m_bits.back() = (1ull << (n % 64)) - 1;
+}
+
+void CandidateSet::narrow(const char* guess, Pattern observed, const LetterColumns& words) {
+    if (m_count == 0) return;
+    m_scratch.resize(m_size); // sized on first use; sets fed by keep() never need it
+    BatchEval::evaluate(guess, words, m_scratch.data());
+    keep(m_scratch.data(), observed);
+}
+
+Pattern CandidateSet::keepLargestBucket(const char* guess, const LetterColumns& words) {
+    const int len = words.length();
+    if (m_count == 0) return 0;
+    m_scratch.resize(m_size);
+    BatchEval::evaluate(guess, words, m_scratch.data());
+
+    // counting sort of the survivors over all 3^len patterns
+    m_buckets.assign(Patterns::count(len), 0);
+    forEach([&](size_t i) { ++m_buckets[m_scratch[i]]; });
+
+    // largest bucket; ties go to the fewest greens, then the fewest yellows
+    Pattern best = 0;
+    uint32_t bestCount = 0;
+    int bestRank = 0;
+    for (size_t b=0; b<m_buckets.size(); ++b) {
+        uint32_t n = m_buckets[b];
+        if (n == 0 || n < bestCount) continue;
+        int greens = 0, yellows = 0;
+        for (size_t d=b; d; d /= 3) { greens += d % 3 == 2; yellows += d % 3 == 1; }
+        int rank = greens * 16 + yellows;
+        if (n > bestCount || rank < bestRank) { best = (Pattern)b; bestCount = n; bestRank = rank; }
+    }
+    keep(m_scratch.data(), best);
+    return best;
+}
+
+void CandidateSet::keep(const Pattern* scored, Pattern observed) {
+    size_t count = 0;
+    const Pattern* p = scored;
+    for (size_t w=0; w<m_bits.size(); ++w) {
+        uint64_t live = m_bits[w];
+        if (!live) continue;
+        uint64_t match = 0;
+        size_t base = w * 64, end = std::min<size_t>(64, m_size - base);
+        for (size_t i=0; i<end; ++i) match |= (uint64_t)(p[base + i] == observed) << i;
+        live &= match;
+        m_bits[w] = live;
+        count += (size_t)std::popcount(live);
+    }
+    m_count = count;
+}
+
+size_t CandidateSet::sample(size_t k, size_t* out) const {
+    size_t n = 0;
+    for (size_t w=0; w<m_bits.size() && n<k; ++w) {
+        for (uint64_t b = m_bits[w]; b && n<k; b &= b - 1)
+            out[n++] = w * 64 + (size_t)std::countr_zero(b);
+    }
+    return n;
+}
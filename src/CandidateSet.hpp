@@ -0,0 +1,47 @@
+#pragma once
+#include "BatchEval.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Bitset over a dictionary of the words still consistent with every
+// feedback row so far. Each guess scores the whole dictionary in one
+// batch and ANDs the matching bits in, 64 words at a time, so the cost
+// does not grow with the number of past guesses.
+class CandidateSet {
+public:
+    // All `n` words possible again; keeps the scratch buffers.
+    void reset(size_t n);
+    // Keep only words w with score(w, guess) == observed.
+    void narrow(const char* guess, Pattern observed, const LetterColumns& words);
+    // Same, with the guess already scored against every word: `scored[i]`
+    // is word i's pattern. Lets several sets share one batch evaluation.
+    void keep(const Pattern* scored, Pattern observed);
+    // Adversarial step: partition the survivors by the pattern `guess`
+    // would get, keep the largest bucket and return its pattern.
+    Pattern keepLargestBucket(const char* guess, const LetterColumns& words);
+
+    size_t size() const { return m_size; }
+    size_t count() const { return m_count; }
+    bool test(size_t i) const { return (m_bits[i >> 6] >> (i & 63)) & 1u; }
+    const std::vector<uint64_t>& bits() const { return m_bits; }
+
+    // First up to `k` surviving word indices; returns how many were written.
+    size_t sample(size_t k, size_t* out) const;
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w=0; w<m_bits.size(); ++w) {
+            for (uint64_t b = m_bits[w]; b; b &= b - 1)
+                fn(w * 64 + (size_t)std::countr_zero(b));
+        }
+    }
+
+private:
+    std::vector<uint64_t> m_bits;
+    std::vector<Pattern> m_scratch; // one pattern per word
+    std::vector<uint32_t> m_buckets; // survivors per pattern, keepLargestBucket()
+    size_t m_size = 0;
+    size_t m_count = 0;
+};
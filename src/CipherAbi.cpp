@@ -0,0 +1,121 @@
+#include "CipherAbi.h"
+#include "BatchEval.hpp"
+#include "Pattern.hpp"
+#include "ThreadPool.hpp"
+#include "WordList.hpp"
+#include <string>
+#include <vector>
+
+struct cipher_words {
+    std::string packed;
+    LetterColumns columns;
+    size_t count = 0;
+    int len = 0;
+};
+
+namespace {
+    // guesses x answers cells below this are not worth starting threads
+    constexpr size_t kParallelCells = 1 << 20;
+
+    bool validLength(int len) { return len >= CIPHER_MIN_LENGTH && len <= CIPHER_MAX_LENGTH; }
+
+    bool validLetters(const char* p, size_t n) {
+        unsigned bad = 0;
+        for (size_t i=0; i<n; ++i) bad |= (unsigned)(uint8_t)(p[i] - 'A') >= 26u;
+        return bad == 0;
+    }
+
+    cipher_words* make(std::string packed, size_t count, int len) {
+        auto* w = new cipher_words;
+        w->packed = std::move(packed);
+        w->count = count;
+        w->len = len;
+        w->columns.assign(w->packed.data(), count, len);
+        return w;
+    }
+}
+
+extern "C" {
+
+int cipher_abi_version(void) { return CIPHER_ABI_VERSION; }
+
+const char* cipher_isa(void) { return BatchEval::name(BatchEval::active()); }
+
+cipher_words* cipher_words_new(const char* packed, size_t count, int len) {
+    if (!validLength(len) || (!packed && count) || !validLetters(packed, count * (size_t)len)) return nullptr;
+    return make(std::string(packed, count * (size_t)len), count, len);
+}
+
+cipher_words* cipher_words_load(const char* path, int len) {
+    if (!path || !validLength(len)) return nullptr;
+    std::vector<std::string> words = WordList::loadFromFile(path, len);
+    std::string packed;
+    packed.reserve(words.size() * (size_t)len);
+    for (const std::string& w : words) packed += w;
+    return make(std::move(packed), words.size(), len);
+}
+
+void cipher_words_free(cipher_words* words) { delete words; }
+
+size_t cipher_words_count(const cipher_words* words) { return words ? words->count : 0; }
+
+int cipher_words_length(const cipher_words* words) { return words ? words->len : 0; }
+
+const char* cipher_words_data(const cipher_words* words) { return words ? words->packed.data() : nullptr; }
+
+int cipher_score(const char* secret, const char* guess, int len) {
+    if (!secret || !guess || !validLength(len) || !validLetters(secret, (size_t)len) ||
+        !validLetters(guess, (size_t)len)) return -1;
+    return Patterns::score(secret, guess, len);
+}
+
+int cipher_evaluate(const cipher_words* answers, const char* guess, uint16_t* out) {
+    if (!answers || !guess || (!out && answers->count) || !validLetters(guess, (size_t)answers->len)) return -1;
+    BatchEval::evaluate(guess, answers->columns, out);
+    return 0;
+}
+
+int cipher_evaluate_many(const cipher_words* answers, const char* guesses,
+                         size_t guessCount, uint16_t* out, int threads) {
+    if (!answers || (guessCount && (!guesses || !out))) return -1;
+    const size_t len = (size_t)answers->len;
+    if (!validLetters(guesses, guessCount * len)) return -1;
+    const size_t n = answers->count;
+    if (threads == 1 || guessCount * n < kParallelCells) {
+        for (size_t g=0; g<guessCount; ++g) BatchEval::evaluate(guesses + g * len, answers->columns, out + g * n);
+        return 0;
+    }
+    ThreadPool pool(threads);
+    pool.parallelFor(guessCount, 16, [&](size_t begin, size_t end) {
+        for (size_t g=begin; g<end; ++g) BatchEval::evaluate(guesses + g * len, answers->columns, out + g * n);
+    });
+    return 0;
+}
+
+long cipher_filter(const cipher_words* answers, const char* guess, uint16_t pattern, uint8_t* keep) {
+    if (!answers || !guess || (!keep && answers->count) || !validLetters(guess, (size_t)answers->len)) return -1;
+    std::vector<Pattern> patterns(answers->count);
+    BatchEval::evaluate(guess, answers->columns, patterns.data());
+    long kept = 0;
+    for (size_t i=0; i<answers->count; ++i) {
+        keep[i] = patterns[i] == pattern;
+        kept += keep[i];
+    }
+    return kept;
+}
+
+uint16_t cipher_pattern_encode(const uint8_t* states, int len) {
+    if (!states || !validLength(len)) return 0;
+    TileState t[Patterns::kMaxLength];
+    for (int i=0; i<len; ++i) t[i] = (TileState)(states[i] > 2 ? 0 : states[i]);
+    return Patterns::encode(t, len);
+}
+
+void cipher_pattern_decode(uint16_t pattern, int len, uint8_t* states) {
+    if (!states || !validLength(len)) return;
+    TileState t[Patterns::kMaxLength];
+    Patterns::decode(pattern, len, t);
+    for (int i=0; i<len; ++i) states[i] = (uint8_t)t[i];
+}
+
+}
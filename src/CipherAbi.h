@@ -0,0 +1,70 @@
+/* C ABI over the evaluation core, built as the cipherc shared library for
+ * other languages (python/cipher.py wraps it with NumPy). Words are passed
+ * packed: `count` words of `len` uppercase letters back to back, no
+ * separators. Patterns use the game's base-3 encoding: tile i adds
+ * state * 3^i with absent 0, present 1, correct 2. Every output buffer is
+ * provided by the caller. Functions taking a handle are safe to call from
+ * several threads at once on the same handle. */
+#ifndef CIPHER_ABI_H
+#define CIPHER_ABI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(CIPHER_ABI_BUILD)
+#    define CIPHER_API __declspec(dllexport)
+#  else
+#    define CIPHER_API __declspec(dllimport)
+#  endif
+#else
+#  define CIPHER_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CIPHER_ABI_VERSION 1
+#define CIPHER_MIN_LENGTH 1
+#define CIPHER_MAX_LENGTH 6
+
+/* Answer list prepared for batch scoring (column-wise letters). */
+typedef struct cipher_words cipher_words;
+
+CIPHER_API int cipher_abi_version(void);
+/* SIMD kernel in use: "avx2", "sse4.2" or "scalar". */
+CIPHER_API const char* cipher_isa(void);
+
+/* NULL if `len` is out of range or a byte is not 'A'..'Z'. */
+CIPHER_API cipher_words* cipher_words_new(const char* packed, size_t count, int len);
+/* Words of `len` letters from a word list file, sorted and deduplicated. */
+CIPHER_API cipher_words* cipher_words_load(const char* path, int len);
+CIPHER_API void cipher_words_free(cipher_words* words);
+CIPHER_API size_t cipher_words_count(const cipher_words* words);
+CIPHER_API int cipher_words_length(const cipher_words* words);
+/* The packed words; valid until cipher_words_free(). */
+CIPHER_API const char* cipher_words_data(const cipher_words* words);
+
+/* Pattern for `guess` against one secret; -1 on bad input. */
+CIPHER_API int cipher_score(const char* secret, const char* guess, int len);
+/* out[i] = pattern of `guess` against word i; 0 on success, -1 on bad input. */
+CIPHER_API int cipher_evaluate(const cipher_words* answers, const char* guess, uint16_t* out);
+/* out[g * count + i] = pattern of guess g against word i, split over
+ * `threads` workers (0 = all cores); 0 on success, -1 on bad input. */
+CIPHER_API int cipher_evaluate_many(const cipher_words* answers, const char* guesses,
+                                    size_t guessCount, uint16_t* out, int threads);
+/* keep[i] = 1 if word i would show `pattern` for `guess`, else 0; returns
+ * how many are kept, or -1 on bad input. */
+CIPHER_API long cipher_filter(const cipher_words* answers, const char* guess,
+                              uint16_t pattern, uint8_t* keep);
+
+/* states[i] in 0..2 <-> pattern */
+CIPHER_API uint16_t cipher_pattern_encode(const uint8_t* states, int len);
+CIPHER_API void cipher_pattern_decode(uint16_t pattern, int len, uint8_t* states);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+#include "Dictionary.hpp"
+#include "WordList.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace {
+    const char kMagic[8] = {'C','P','H','R','D','I','C','\0'};
+
+    // letters A-Z only, words strictly increasing
+    bool validSection(const uint8_t* p, const DictionaryFile::SectionEntry& s) {
+        const size_t n = (size_t)s.count * s.length;
+        for (size_t i=0; i<n; ++i)
+            if (p[i] < 'A' || p[i] > 'Z') return false;
+        for (size_t w=1; w<s.count; ++w)
+            if (std::memcmp(p + (w - 1) * s.length, p + w * s.length, s.length) >= 0) return false;
+        return true;
+    }
+
+    bool endsWith(const std::string& s, const char* suffix) {
+        size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+}
+
+Dictionary Dictionary::fromWords(std::vector<std::string> words) {
+    Dictionary d;
+    if (words.empty()) return d;
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    d.m_len = (int)words[0].size();
+    d.m_count = words.size();
+    auto buf = std::make_shared<std::vector<char>>(d.m_count * d.m_len);
+    for (size_t i=0; i<d.m_count; ++i)
+        std::memcpy(buf->data() + i * d.m_len, words[i].data(), d.m_len);
+    d.m_data = buf->data();
+    d.m_owner = std::move(buf);
+    return d;
+}
+
+Dictionary Dictionary::fromPacked(std::string_view letters, int len) {
+    Dictionary d;
+    if (len <= 0 || letters.size() < (size_t)len) return d;
+    d.m_len = len;
+    d.m_count = letters.size() / len;
+    d.m_data = letters.data();
+    return d;
+}
+
+Dictionary Dictionary::load(const std::string& path, int len) {
+    if (endsWith(path, ".bin")) {
+        DictionaryFile f;
+        return f.open(path) ? f.section(len) : Dictionary{};
+    }
+    return fromWords(WordList::loadFromFile(path, len));
+}
+
+long Dictionary::find(std::string_view w) const {
+    if ((int)w.size() != m_len) return -1;
+    size_t lo = 0, hi = m_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        int c = std::memcmp(m_data + mid * m_len, w.data(), m_len);
+        if (c == 0) return (long)mid;
+        if (c < 0) lo = mid + 1; else hi = mid;
+    }
+    return -1;
+}
+
+bool DictionaryFile::open(const std::string& path) {
+    m_file.reset();
+    m_sections.clear();
+    auto f = std::make_shared<MappedFile>();
+    if (!f->open(path) || f->size() < sizeof(FileHeader)) return false;
+
+    FileHeader h;
+    std::memcpy(&h, f->data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion) return false;
+    size_t tableEnd = sizeof(FileHeader) + (size_t)h.sections * sizeof(SectionEntry);
+    if (tableEnd > f->size()) return false;
+
+    m_sections.resize(h.sections);
+    std::memcpy(m_sections.data(), f->data() + sizeof(FileHeader), h.sections * sizeof(SectionEntry));
+    for (const auto& s : m_sections) {
+        // overflow-safe: offset + count * length <= size
+        if (s.length == 0 || s.offset < tableEnd || s.offset > f->size() ||
+            s.count > (f->size() - s.offset) / s.length || !validSection(f->data() + s.offset, s)) {
+            m_sections.clear();
+            return false;
+        }
+    }
+    m_file = std::move(f);
+    return true;
+}
+
+Dictionary DictionaryFile::section(int len) const {
+    Dictionary d;
+    if (!m_file) return d;
+    for (const auto& s : m_sections) {
+        if ((int)s.length != len) continue;
+        d.m_owner = m_file;
+        d.m_data = (const char*)m_file->data() + s.offset;
+        d.m_count = (size_t)s.count;
+        d.m_len = len;
+        break;
+    }
+    return d;
+}
+
+bool DictionaryFile::write(const std::string& path, const std::vector<std::string>& words) {
+    std::map<int, std::vector<std::string>> byLen;
+    for (const auto& w : words) if (!w.empty()) byLen[(int)w.size()].push_back(w);
+
+    std::vector<Dictionary> packed;
+    for (auto& [len, list] : byLen) packed.push_back(Dictionary::fromWords(std::move(list)));
+
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.sections = (uint32_t)packed.size();
+
+    std::vector<SectionEntry> table;
+    uint64_t offset = sizeof(FileHeader) + packed.size() * sizeof(SectionEntry);
+    for (const auto& d : packed) {
+        table.push_back({(uint32_t)d.length(), 0, (uint64_t)d.size(), offset});
+        offset += (uint64_t)d.size() * d.length();
+    }
+
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)table.data(), (std::streamsize)(table.size() * sizeof(SectionEntry)));
+        for (const auto& d : packed)
+            out.write(d.data(), (std::streamsize)(d.size() * d.length()));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { std::filesystem::remove(tmp, ec); return false; }
+    return true;
+}
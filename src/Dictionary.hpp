@@ -0,0 +1,77 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Sorted, deduplicated words of one length packed back to back
+// (length bytes each, no separators). The letters either sit in a
+// memory-mapped compiled dictionary (see cipher-dictc) or in one heap
+// block; copies share the backing store.
+class Dictionary {
+public:
+    Dictionary() = default;
+
+    // Packs `words` (all of one length) after sorting and deduplicating.
+    static Dictionary fromWords(std::vector<std::string> words);
+    // Uses `letters` in place: already sorted and duplicate-free, and alive
+    // for as long as any copy (static data such as WordList::builtin()).
+    static Dictionary fromPacked(std::string_view letters, int len);
+    // `.bin` paths are mapped as compiled dictionaries, anything else is
+    // parsed as a text word list.
+    static Dictionary load(const std::string& path, int len);
+
+    bool empty() const { return m_count == 0; }
+    size_t size() const { return m_count; }
+    int length() const { return m_len; }
+    std::string_view operator[](size_t i) const { return {m_data + i * m_len, (size_t)m_len}; }
+    const char* data() const { return m_data; }
+
+    // binary search; the section is sorted
+    bool contains(std::string_view w) const { return find(w) >= 0; }
+    long find(std::string_view w) const;
+
+private:
+    friend class DictionaryFile;
+    std::shared_ptr<const void> m_owner; // MappedFile or heap buffer
+    const char* m_data = nullptr;
+    size_t m_count = 0;
+    int m_len = 0;
+};
+
+// Compiled dictionary: a header, a section table and one packed, sorted
+// section per word length. Layout (little endian):
+//   FileHeader | SectionEntry x sections | letters...
+class DictionaryFile {
+public:
+    struct FileHeader {
+        char     magic[8];   // "CPHRDIC\0"
+        uint32_t version;
+        uint32_t sections;
+    };
+    struct SectionEntry {
+        uint32_t length;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t offset;     // from the start of the file
+    };
+    static constexpr uint32_t kVersion = 1;
+
+    // False unless every section lies inside the file and holds only A-Z
+    // words in strictly increasing order (find() binary-searches them and
+    // WordCodes/BatchEval index by letter - 'A').
+    bool open(const std::string& path);
+    bool isOpen() const { return m_file != nullptr; }
+    // Words of length `len`, or an empty dictionary.
+    Dictionary section(int len) const;
+
+    // Writes every length in `words` (any order, duplicates allowed).
+    static bool write(const std::string& path, const std::vector<std::string>& words);
+
+private:
+    std::shared_ptr<const MappedFile> m_file;
+    std::vector<SectionEntry> m_sections;
+};
@@ -0,0 +1,126 @@
+#include "FrameProfiler.hpp"
+#include "AllocCounter.hpp"
+#include <imgui.h>
+#include <algorithm>
+
+uint64_t FrameProfiler::allocations() {
+    return AllocCounter::count();
+}
+
+const char* FrameProfiler::name(Phase phase) {
+    static const char* names[PhaseCount] = {
+        "idle", "poll", "imgui update", "game update", "renderUI",
+        "  drawBoard", "  drawKeyboard", "  footer", "imgui render", "display"
+    };
+    return names[phase];
+}
+
+void FrameProfiler::beginFrame() {
+    m_cur = Sample{};
+    m_cur.frame = m_frame++;
+    m_frameStart = std::chrono::steady_clock::now();
+    m_allocStart = allocations();
+}
+
+void FrameProfiler::endFrame() {
+    float wall = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+    m_cur.total = std::max(0.f, wall - m_cur.ms[Idle]);
+    m_cur.allocs = (uint32_t)(allocations() - m_allocStart);
+
+    m_history[m_head] = m_cur;
+    m_head = (m_head + 1) % kHistory;
+    m_count = std::min(m_count + 1, kHistory);
+
+    if (m_csv && !m_ring.push(m_cur)) ++m_dropped;
+}
+
+bool FrameProfiler::startCsv(const std::string& path) {
+    stopCsv();
+    m_csv = std::fopen(path.c_str(), "w");
+    if (!m_csv) return false;
+    m_csvPath = path;
+    std::fprintf(m_csv, "frame,total_ms,allocs");
+    for (int p=0; p<PhaseCount; ++p) {
+        const char* n = name((Phase)p);
+        while (*n == ' ') ++n;
+        std::fprintf(m_csv, ",%s_ms", n);
+    }
+    std::fprintf(m_csv, "\n");
+    m_dropped = 0;
+    m_stop = false;
+    m_writer = std::thread(&FrameProfiler::writerLoop, this);
+    return true;
+}
+
+void FrameProfiler::stopCsv() {
+    if (!m_csv) return;
+    m_stop = true;
+    m_writer.join();
+    std::fclose(m_csv);
+    m_csv = nullptr;
+}
+
+void FrameProfiler::writerLoop() {
+    Sample s;
+    for (;;) {
+        bool stopping = m_stop.load(std::memory_order_acquire);
+        while (m_ring.pop(s)) {
+            std::fprintf(m_csv, "%llu,%.4f,%u", (unsigned long long)s.frame, s.total, s.allocs);
+            for (int p=0; p<PhaseCount; ++p) std::fprintf(m_csv, ",%.4f", s.ms[p]);
+            std::fprintf(m_csv, "\n");
+        }
+        if (stopping) break; // drained everything pushed before the stop
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+void FrameProfiler::drawOverlay() {
+    if (!m_visible || m_count == 0) return;
+
+    // percentile of one column over the history window; scratch avoids allocating
+    auto percentile = [&](auto value, float q) {
+        for (int i=0; i<m_count; ++i) m_scratch[i] = value(m_history[i]);
+        int k = std::min(m_count - 1, (int)(q * m_count));
+        std::nth_element(m_scratch.begin(), m_scratch.begin() + k, m_scratch.begin() + m_count);
+        return m_scratch[k];
+    };
+    const Sample& last = m_history[(m_head + kHistory - 1) % kHistory];
+
+    ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 10.f, 30.f), ImGuiCond_Always, ImVec2(1.f, 0.f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    ImGui::Begin("frame profiler", nullptr,
+        ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+
+    ImGui::Text("%-14s %7s %7s %7s", "phase (ms)", "last", "p50", "p99");
+    ImGui::Separator();
+    for (int p=0; p<PhaseCount; ++p) {
+        ImGui::Text("%-14s %7.3f %7.3f %7.3f", name((Phase)p), last.ms[p],
+                    percentile([p](const Sample& s) { return s.ms[p]; }, 0.50f),
+                    percentile([p](const Sample& s) { return s.ms[p]; }, 0.99f));
+    }
+    ImGui::Separator();
+    float p50 = percentile([](const Sample& s) { return s.total; }, 0.50f);
+    float p99 = percentile([](const Sample& s) { return s.total; }, 0.99f);
+    ImGui::Text("%-14s %7.3f %7.3f %7.3f", "frame (busy)", last.total, p50, p99);
+    ImGui::Text("%-14s %7u %7.0f %7.0f", "allocations", last.allocs,
+                percentile([](const Sample& s) { return (float)s.allocs; }, 0.50f),
+                percentile([](const Sample& s) { return (float)s.allocs; }, 0.99f));
+
+    // busy frame time, oldest to newest
+    for (int i=0; i<m_count; ++i) {
+        int at = (m_head - m_count + i + kHistory) % kHistory;
+        m_scratch[i] = m_history[at].total;
+    }
+    ImGui::PlotHistogram("##frames", m_scratch.data(), m_count, 0, nullptr, 0.f,
+                         std::max(p99 * 1.25f, 1.f), ImVec2(320.f, 60.f));
+
+    if (!recording()) {
+        if (ImGui::SmallButton("record csv")) startCsv("frames.csv");
+    } else {
+        if (ImGui::SmallButton("stop")) stopCsv();
+        ImGui::SameLine();
+        ImGui::TextDisabled("-> %s (%llu dropped)", m_csvPath.c_str(), (unsigned long long)m_dropped);
+    }
+    ImGui::End();
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "SpscRing.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// Per-phase timings of the main loop. Phases are timed with Scope; the
+// last few seconds are kept for the overlay (p50/p99 + histogram), and
+// while CSV recording is on every frame is also pushed through a lock-free
+// ring to a writer thread so file I/O never lands on the frame.
+class FrameProfiler {
+public:
+    enum Phase {
+        Idle,          // blocked waiting for input / the next animation step
+        Poll,          // event polling + dispatch
+        ImGuiUpdate,   // ImGui::SFML::Update
+        GameUpdate,    // Game::update
+        RenderUI,      // Game::renderUI (includes the three below)
+        DrawBoard,
+        DrawKeyboard,
+        Footer,
+        ImGuiRender,   // ImGui::SFML::Render
+        Display,       // window.display (includes the 60 fps limiter sleep)
+        PhaseCount
+    };
+
+    struct Sample {
+        uint64_t frame = 0;
+        float ms[PhaseCount] = {};
+        float total = 0.f;    // frame time excluding Idle
+        uint32_t allocs = 0;  // operator new calls during the frame
+    };
+
+    class Scope {
+    public:
+        Scope(FrameProfiler* prof, Phase phase)
+            : m_prof(prof), m_phase(phase), m_t0(std::chrono::steady_clock::now()) {}
+        ~Scope() {
+            if (m_prof) m_prof->add(m_phase, std::chrono::duration<float, std::milli>(
+                                                 std::chrono::steady_clock::now() - m_t0).count());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FrameProfiler* m_prof;
+        Phase m_phase;
+        std::chrono::steady_clock::time_point m_t0;
+    };
+
+    FrameProfiler() = default;
+    ~FrameProfiler() { stopCsv(); }
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    void add(Phase phase, float ms) { m_cur.ms[phase] += ms; }
+
+    // overlay, toggled with F3
+    void toggle() { m_visible = !m_visible; }
+    bool visible() const { return m_visible; }
+    void drawOverlay();
+
+    bool startCsv(const std::string& path);
+    void stopCsv();
+    bool recording() const { return m_csv != nullptr; }
+
+    static const char* name(Phase phase);
+    static uint64_t allocations(); // operator new calls since startup
+
+private:
+    void writerLoop();
+
+    static constexpr int kHistory = 240; // ~4 s at 60 fps
+
+    Sample m_cur;
+    std::chrono::steady_clock::time_point m_frameStart;
+    uint64_t m_allocStart = 0;
+    uint64_t m_frame = 0;
+    bool m_visible = false;
+
+    std::array<Sample, kHistory> m_history{};
+    int m_head = 0, m_count = 0;
+    std::array<float, kHistory> m_scratch{};
+
+    SpscRing<Sample, 1024> m_ring;
+    std::FILE* m_csv = nullptr;
+    std::string m_csvPath;
+    std::thread m_writer;
+    std::atomic<bool> m_stop{false};
+    uint64_t m_dropped = 0;
+};
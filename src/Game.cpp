@@ -1,12 +1,13 @@
 #include "Game.hpp"
-#include "WordList.hpp"
 #include <imgui-SFML.h>
 #include <imgui.h>
-#include <chrono>
 #include <algorithm>
 #include <cctype>
-#include <sstream>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <ctime>
 
 namespace {
     ImVec4 colAbsent    = ImVec4(0.12f, 0.12f, 0.14f, 1.0f);
@@ -21,416 +22,358 @@ namespace {
         "ASDFGHJKL",
         "ZXCVBNM"
     };
-}
 
-Game::Game() {
-    std::random_device rd;
-    m_rng.seed(rd());
-    newGame(m_cfg);
-}
+    // heatmap brightness a key converges to for its keyState
+    float keyTarget(int state) {
+        if (state == 2) return 1.f;    // Correct - full brightness
+        if (state == 1) return 0.7f;   // Present - medium brightness
+        if (state == -1) return 0.8f;  // Wrong - high brightness for red
+        return 0.f;                    // Unused - no brightness
+    }
 
-std::string Game::toUpper(const std::string& s) {
-    std::string t = s;
-    for (auto& c : t) c = (char)std::toupper((unsigned char)c);
-    return t;
-}
-bool Game::isAlpha(const std::string& s) {
-    return std::all_of(s.begin(), s.end(), [](unsigned char c){ return std::isalpha(c); });
-}
-char Game::caesarShiftChar(char c, int k) {
-    if (c < 'A' || c > 'Z') return c;
-    int x = c - 'A';
-    x = (x + k) % 26;
-    return (char)('A' + x);
-}
-std::string Game::caesarShift(const std::string& s, int k) {
-    std::string o; o.reserve(s.size());
-    for (char c : s) o.push_back(caesarShiftChar(c, k));
-    return o;
-}
-uint64_t Game::dailySeed() {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto days = duration_cast<hours>(now.time_since_epoch()).count() / 24;
-    uint64_t x = (uint64_t)days;
-    x ^= (x << 23); x ^= (x >> 17); x ^= (x << 5);
-    return x;
+    const float kTitleStep = 0.15f;    // seconds per typed/erased title letter
+    const float kTitleHold = 0.5f;     // full word shown before erasing
+    const float kTitleRest = 0.3f;     // empty title before typing again
+    const float kKeyFade = 0.6f;       // heatmap fade to a new key state
 }
 
-void Game::pickSecret() {
-    if (m_dict.empty()) {
-        m_dict = WordList::loadBuiltin(m_cfg.length);
-    }
-    if (m_cfg.daily) {
-        uint64_t s = dailySeed();
-        m_secret = m_dict[s % m_dict.size()];
-    } else {
-        std::uniform_int_distribution<size_t> d(0, m_dict.size()-1);
-        m_secret = m_dict[d(m_rng)];
-    }
-    // setup clue + reveals
-    std::uniform_int_distribution<int> kd(1, 25);
-    m_caesarKey = kd(m_rng);
-    m_cipherClue = caesarShift(m_secret, m_caesarKey);
-    m_revealMask.assign(m_cfg.length, false);
+Game::Game(uint64_t seed) : m_core(seed) {
+    newGame(m_core.config());
 }
 
 void Game::newGame(const GameConfig& cfg) {
-    m_cfg = cfg;
-    // load dict for length
-    m_dict = WordList::loadFromFile("assets/words.txt", m_cfg.length);
-    if (m_dict.empty()) m_dict = WordList::loadBuiltin(m_cfg.length);
-    m_valid.clear();
-    for (auto& w : m_dict) m_valid.insert(w);
-
-    // rows/states
-    m_rows.assign(m_cfg.attempts, std::string(m_cfg.length, ' '));
-    m_states.assign(m_cfg.attempts, std::vector<TileState>(m_cfg.length, TileState::Absent));
-    m_flip.assign(m_cfg.attempts, std::vector<float>(m_cfg.length, 1.f));
-    m_rowIndex = 0; m_current.clear();
-    std::fill(std::begin(m_keyState), std::end(m_keyState), 0);
-    for (int i=0;i<26;++i) m_keyAnim[i] = 0.f;
-    m_win = false; m_outOfAttempts = false;
-    m_msg.clear(); m_msgTimer = 0.f;
-
-    pickSecret();
+    if (m_log) m_log->newGame(cfg);
+    m_core.newGame(cfg);
+    resetAnimations();
+    m_msg[0] = '\0'; m_msgTimer = 0.f;
+    m_suggestDirty = true;
 }
 
 void Game::restart() {
-    m_rowIndex = 0; m_current.clear();
-    std::fill(std::begin(m_keyState), std::end(m_keyState), 0);
-    for (int i=0;i<26;++i) m_keyAnim[i] = 0.f;
-    m_win = false; m_outOfAttempts = false;
-    std::fill(m_rows.begin(), m_rows.end(), std::string(m_cfg.length, ' '));
-    for (auto& r : m_states) std::fill(r.begin(), r.end(), TileState::Absent);
-    m_flip.assign(m_cfg.attempts, std::vector<float>(m_cfg.length, 1.f));
+    if (m_log) m_log->restart();
+    m_core.restart();
+    resetAnimations();
+    m_suggestDirty = true;
     // keep same secret & clue
 }
 
-std::vector<TileState> Game::evaluate(const std::string& guess) const {
-    std::vector<TileState> out(m_cfg.length, TileState::Absent);
-    std::vector<int> counts(26, 0);
-    for (int i=0;i<m_cfg.length;++i) counts[m_secret[i]-'A']++;
+void Game::setLenient(bool lenient) {
+    if (m_log) m_log->lenient(lenient);
+    m_core.setLenient(lenient);
+}
 
-    // correct
-    for (int i=0;i<m_cfg.length;++i) {
-        if (guess[i] == m_secret[i]) {
-            out[i] = TileState::Correct;
-            counts[guess[i]-'A']--;
-        }
-    }
-    // present
-    for (int i=0;i<m_cfg.length;++i) {
-        if (out[i] == TileState::Absent) {
-            int idx = guess[i]-'A';
-            if (idx>=0 && idx<26 && counts[idx] > 0) {
-                out[i] = TileState::Present;
-                counts[idx]--;
-            }
-        }
+void Game::setJournal(StatsJournal* journal) {
+    m_journal = journal;
+    if (m_journal) m_allTime = m_journal->stats(StatsJournal::Player);
+}
+
+void Game::resetAnimations() {
+    // tweens point into the vectors below
+    m_tweens.clear();
+    const int boards = m_core.boards();
+    m_flip.assign((size_t)boards * m_core.rows() * m_core.config().length, 1.f);
+    m_keyAnim.assign((size_t)boards * 26, 0.f);
+    if (!m_titleParked) {
+        m_tweens.after(kTitleStep, titleStep, this);
     }
-    return out;
 }
 
 bool Game::onTextEntered(sf::Uint32 uni) {
-    if (m_win || m_outOfAttempts) return false;
-    if (uni >= 32 && uni < 128) {
-        char c = (char)uni;
-        if (std::isalpha((unsigned char)c)) {
-            if ((int)m_current.size() < m_cfg.length) {
-                m_current.push_back((char)std::toupper((unsigned char)c));
-                return true;
-            }
-        }
+    if (m_log) m_log->text(uni);
+    m_idleTime = 0.f;
+    if (uni >= 32 && uni < 128 && m_core.typeLetter((char)uni)) {
+        m_suggestDirty = true;
+        return true;
     }
     return false;
 }
 
 bool Game::onKeyPressed(sf::Keyboard::Key key) {
+    if (m_log) m_log->key((int)key);
+    m_idleTime = 0.f;
     if (key == sf::Keyboard::Backspace) {
-        if (!m_current.empty()) {
-            m_current.pop_back();
-            return true;
-        }
+        if (!m_core.backspace()) return false;
+        m_suggestDirty = true;
+        return true;
     } else if (key == sf::Keyboard::Enter || key == sf::Keyboard::Return) {
-        if ((int)m_current.size() == m_cfg.length) {
-            if (!m_valid.empty() && !m_valid.count(m_current) && !m_lenient) {
-                m_msg = "Word not in list"; m_msgTimer = 2.0f; return false;
-            }
-            auto st = evaluate(m_current);
-            m_states[m_rowIndex] = st;
-            m_rows[m_rowIndex] = m_current;
-            for (int i=0;i<m_cfg.length;++i) m_flip[m_rowIndex][i] = 0.f;
-            for (int i=0;i<m_cfg.length;++i) {
-                int idx = m_current[i]-'A';
-                int val = (st[i]==TileState::Correct?2:(st[i]==TileState::Present?1:0));
-                m_keyState[idx] = std::max(m_keyState[idx], val);
-            }
-            
-            // Mark letters that are completely wrong (not present in the word at all)
-            for (int i=0;i<m_cfg.length;++i) {
-                if (st[i] == TileState::Absent) {
-                    int idx = m_current[i]-'A';
-                    // Check if this letter appears anywhere in the word
-                    bool letterInWord = false;
-                    for (int j=0;j<m_cfg.length;++j) {
-                        if (m_secret[j] == m_current[i]) {
-                            letterInWord = true;
-                            break;
-                        }
-                    }
-                    // If letter is not in word at all, mark it as wrong
-                    if (!letterInWord) {
-                        m_keyState[idx] = -1; // Use -1 to indicate wrong letter
-                    }
+        int row = m_core.rowIndex();
+        switch (m_core.submit()) {
+        case SubmitResult::Accepted: {
+            m_suggestDirty = true;
+            // flip the new row on every board that took it, and fade the
+            // keys of its letters towards their new states
+            const int len = m_core.config().length;
+            const std::string& word = m_core.row(row);
+            for (int b=0;b<m_core.boards();++b) {
+                int solved = m_core.solvedAt(b);
+                if (solved >= 0 && solved < row) continue;
+                float* f = m_flip.data() + ((size_t)b * m_core.rows() + row) * len;
+                for (int c=0;c<len;++c) {
+                    f[c] = 0.f;
+                    m_tweens.start(f + c, 1.f, 1.f / m_flipSpeed);
                 }
-            }
-            if (m_current == m_secret) {
-                m_win = true;
-                m_stats.record(true, m_rowIndex+1);
-            } else {
-                pushHintProgression();
-                m_rowIndex++;
-                if (m_rowIndex >= m_cfg.attempts) {
-                    m_outOfAttempts = true;
-                    m_stats.record(false, m_cfg.attempts);
+                for (char ch : word) {
+                    const int i = ch - 'A';
+                    float target = keyTarget(m_core.keyState(i, b));
+                    float* a = m_keyAnim.data() + b * 26 + i;
+                    if (*a != target) m_tweens.retarget(a, target, kKeyFade, Ease::OutCubic);
                 }
             }
-            m_current.clear();
+            if (m_journal && m_core.finished()) {
+                StatsJournal::Record rec = StatsJournal::fromGame(m_core, StatsJournal::Player, (int64_t)std::time(nullptr));
+                m_allTime.record((rec.flags & StatsJournal::kWin) != 0, rec.attempts);
+                m_journal->append(rec);
+                m_journal->flush();
+            }
             return true;
-        } else {
-            m_msg = "Not enough letters"; m_msgTimer = 1.5f;
         }
-    }
-    return false;
-}
-
-void Game::pushHintProgression() {
-    int used = m_rowIndex + 1;
-    if (used >= 4) {
-        std::vector<int> idx;
-        for (int i=0;i<m_cfg.length;++i) if (!m_revealMask[i]) idx.push_back(i);
-        if (!idx.empty()) {
-            std::uniform_int_distribution<int> d(0, (int)idx.size()-1);
-            m_revealMask[idx[d(m_rng)]] = true;
+        case SubmitResult::NotInList: {
+            size_t idx[3];
+            size_t found = m_core.nearest(m_core.current(), idx, 3);
+            int n = std::snprintf(m_msg, sizeof(m_msg), found ? "Not in list - did you mean" : "Word not in list");
+            for (size_t i=0; i<found && n < (int)sizeof(m_msg); ++i) {
+                std::string_view w = m_core.dictionary()[idx[i]];
+                n += std::snprintf(m_msg + n, sizeof(m_msg) - n, "%s %.*s", i ? "," : "", (int)w.size(), w.data());
+            }
+            if (found && n < (int)sizeof(m_msg)) std::snprintf(m_msg + n, sizeof(m_msg) - n, "?");
+            m_msgTimer = found ? 3.0f : 2.0f;
+            break;
+        }
+        case SubmitResult::TooShort:
+            std::snprintf(m_msg, sizeof(m_msg), "Not enough letters"); m_msgTimer = 1.5f;
+            break;
+        case SubmitResult::Finished:
+            break;
         }
     }
+    return false;
 }
 
 void Game::update(float dt) {
+    if (m_log) m_log->frame(dt);
+    m_idleTime += dt;
     if (m_msgTimer > 0.f) { m_msgTimer -= dt; if (m_msgTimer < 0.f) m_msgTimer = 0.f; }
-    for (int i=0;i<26;++i) {
-        float target;
-        if (m_keyState[i] == 2) {
-            target = 1.f; // Correct - full brightness
-        } else if (m_keyState[i] == 1) {
-            target = 0.7f; // Present - medium brightness
-        } else if (m_keyState[i] == -1) {
-            target = 0.8f; // Wrong - high brightness for red
-        } else {
-            target = 0.f; // Unused - no brightness
-        }
-        float a = m_keyAnim[i];
-        a += (target - a) * (dt * 6.f);
-        if (a < 0.001f) a = 0.f; if (a > 0.999f) a = target;
-        m_keyAnim[i] = a;
+
+    m_tweens.update(dt);
+
+    // input since the title parked: hold the word, then start erasing it
+    if (m_titleParked && m_idleTime < m_titleIdleAfter) {
+        m_titleParked = false;
+        m_titleBackspacing = true;
+        m_tweens.after(kTitleHold, titleStep, this);
     }
-    for (int r=0; r<=m_rowIndex && r < (int)m_flip.size(); ++r) {
-        for (int c=0; c<m_cfg.length; ++c) {
-            float& f = m_flip[r][c];
-            if (f < 1.f) f = std::min(1.f, f + dt * m_flipSpeed);
+}
+
+void Game::titleStep(void* game, uint32_t) { static_cast<Game*>(game)->advanceTitle(); }
+
+void Game::advanceTitle() {
+    const int len = (int)m_titleText.size();
+    float next = kTitleStep;
+    if (!m_titleBackspacing) {
+        if (++m_titleCharIndex >= len) {
+            m_titleCharIndex = len;
+            // park on the full word once nobody has touched anything for a while
+            if (m_idleTime >= m_titleIdleAfter) { m_titleParked = true; return; }
+            m_titleBackspacing = true;
+            next = kTitleHold;
         }
+    } else if (--m_titleCharIndex <= 0) {
+        m_titleCharIndex = 0;
+        m_titleBackspacing = false;
+        next = kTitleRest;
     }
-    
-    // Update title typing animation
-    m_titleAnimTimer += dt;
-    
-    if (m_titleAnimTimer >= 0.15f) { // Adjust speed here
-        m_titleAnimTimer = 0.f;
-        
-        if (!m_titleBackspacing) {
-            // Typing forward
-            if (m_titleCharIndex < (int)m_titleText.length()) {
-                m_titleCharIndex++;
-            } else {
-                // Wait a bit before starting to backspace
-                m_titleAnimTimer = -0.5f; // Wait 0.5 seconds
-            }
-        } else {
-            // Backspacing
-            if (m_titleCharIndex > 0) {
-                m_titleCharIndex--;
-            } else {
-                m_titleBackspacing = false;
-                // Wait a bit before starting to type again
-                m_titleAnimTimer = -0.3f; // Wait 0.3 seconds
-            }
+    m_tweens.after(next, titleStep, this);
+}
+
+float Game::redrawIn() const {
+    // nothing moving: only wake for the next discrete change
+    float wait = m_tweens.nextWake();
+    if (m_msgTimer > 0.f) wait = std::min(wait, m_msgTimer);
+    return wait;
+}
+
+void Game::layoutBoard(const ImVec2& window) {
+    const GameConfig& cfg = m_core.config();
+    Layout& L = m_layout;
+    L.window = window;
+    L.length = cfg.length;
+    L.rows = m_core.rows();
+    L.boards = m_core.boards();
+
+    float tile = m_tileSize, gap = m_tileGap, boardGap = 0.f;
+    int cols = 1;
+    if (L.boards > 1) {
+        // largest tile for which some grid of boards fits between the menu
+        // bar and the footer; gaps scale with the tile
+        const float gapK = m_tileGap / m_tileSize, boardK = 0.6f;
+        float areaW = window.x - 20.f, areaH = window.y - 60.f - 300.f;
+        tile = 0.f;
+        for (int c=1; c<=L.boards; ++c) {
+            int gr = (L.boards + c - 1) / c;
+            float tw = areaW / (c * (L.length + (L.length - 1) * gapK) + (c - 1) * boardK);
+            float th = areaH / (gr * (L.rows + (L.rows - 1) * gapK) + (gr - 1) * boardK);
+            float t = std::min({tw, th, m_tileSize});
+            if (t > tile) { tile = t; cols = c; }
         }
+        tile = std::max(tile, 1.f);
+        gap = tile * gapK;
+        boardGap = tile * boardK;
     }
-    
-    // Check if we should switch direction after waiting
-    if (m_titleAnimTimer < 0.f) {
-        if (!m_titleBackspacing && m_titleCharIndex >= (int)m_titleText.length()) {
-            // Switch to backspacing after waiting
-            m_titleBackspacing = true;
-            m_titleAnimTimer = 0.f;
-        } else if (m_titleBackspacing && m_titleCharIndex <= 0) {
-            // Switch to typing after waiting
-            m_titleBackspacing = false;
-            m_titleAnimTimer = 0.f;
-        }
+    L.tile = tile;
+    int gridRows = (L.boards + cols - 1) / cols;
+
+    float boardWidth = L.length * tile + (L.length - 1) * gap;
+    float boardHeight = L.rows * tile + (L.rows - 1) * gap;
+    float gridWidth = cols * boardWidth + (cols - 1) * boardGap;
+    float gridHeight = gridRows * boardHeight + (gridRows - 1) * boardGap;
+    // one board: centered on the whole window, title 80px above it;
+    // several: centered in the space above the footer, no title
+    float startX = (window.x - gridWidth) * 0.5f;
+    float startY = L.boards > 1 ? 60.f + (window.y - 60.f - 300.f - gridHeight) * 0.5f
+                                : (window.y - gridHeight) * 0.5f;
+    L.title = ImVec2(startX, startY - 80.f);
+    L.boardEnd = ImVec2(0, startY + gridHeight);
+
+    L.origins.resize(L.boards);
+    for (int b=0;b<L.boards;++b)
+        L.origins[b] = ImVec2(startX + (b % cols) * (boardWidth + boardGap),
+                              startY + (b / cols) * (boardHeight + boardGap));
+    L.tiles.resize((size_t)L.rows * L.length);
+    for (int r=0;r<L.rows;++r)
+        for (int c=0;c<L.length;++c)
+            L.tiles[(size_t)r * L.length + c] = ImVec2(c * (tile + gap), r * (tile + gap));
+}
+
+void Game::layoutKeyboard(float width) {
+    Layout& L = m_layout;
+    L.keysWidth = width;
+    L.keysBoards = m_core.boards();
+    float widest = 0.f;
+    for (int ri=0; ri<3; ++ri) {
+        const char* row = kbdRows[ri];
+        int n = (int)std::strlen(row);
+        float rowWidth = n * m_keySize.x + (n - 1) * m_keyGap;
+        float startX = std::max(0.f, (width - rowWidth) * 0.5f);
+        widest = std::max(widest, startX + rowWidth);
+        for (int i=0;i<n;++i)
+            L.keys[row[i] - 'A'] = ImVec2(startX + i * (m_keySize.x + m_keyGap), ri * (m_keySize.y + m_keyRowGap));
     }
+    L.keysSize = ImVec2(widest, 3 * m_keySize.y + 2 * m_keyRowGap);
 }
 
 void Game::drawBoard() {
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 8.f);
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.f);
-
-    // Calculate the total board dimensions
-    float boardWidth = m_cfg.length * m_tileSize + (m_cfg.length - 1) * m_tileGap;
-    
-    // Get the window size and center the board on the entire screen
+    const GameConfig& cfg = m_core.config();
     ImVec2 windowSize = ImGui::GetWindowSize();
-    float startX = (windowSize.x - boardWidth) * 0.5f;
-    
-    // Center the board vertically as well
-    float boardHeight = m_cfg.attempts * m_tileSize + (m_cfg.attempts - 1) * m_tileGap;
-    float startY = (windowSize.y - boardHeight) * 0.5f;
-    
-    // Draw the animated "CIPHER" title above the board
-    float titleY = startY - 80.f; // Position above the board
-    ImGui::SetCursorPos(ImVec2(startX, titleY));
-    
-    // Style the title to make it look cool
-    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.8f, 0.8f, 1.0f, 1.0f)); // Light blue color
-    ImGui::SetWindowFontScale(2.5f); // Make it larger
-    
-    // Display the animated title text
-    std::string displayText = m_titleText.substr(0, m_titleCharIndex);
-    if (!m_titleBackspacing && m_titleCharIndex < (int)m_titleText.length()) {
-        displayText += "|"; // Add cursor when typing
+    if (windowSize.x != m_layout.window.x || windowSize.y != m_layout.window.y ||
+        cfg.length != m_layout.length || m_core.rows() != m_layout.rows ||
+        m_core.boards() != m_layout.boards) {
+        layoutBoard(windowSize);
     }
-    ImGui::Text("%s", displayText.c_str());
-    
-    ImGui::SetWindowFontScale(1.0f); // Reset font scale
-    ImGui::PopStyleColor();
-    
-    for (int r=0;r<m_cfg.attempts;++r) {
-        for (int c=0;c<m_cfg.length;++c) {
-            // Calculate absolute position for each tile relative to screen center
-            float tileX = startX + c * (m_tileSize + m_tileGap);
-            float tileY = startY + r * (m_tileSize + m_tileGap);
-            
-            // Set cursor to exact position for this tile
-            ImGui::SetCursorPos(ImVec2(tileX, tileY));
-            
-            TileState ts = m_states[r][c];
-            ImVec4 fill = colAbsent;
-            if (ts == TileState::Present) fill = colPresent;
-            else if (ts == TileState::Correct) fill = colCorrect;  
-
-            float flip = (r < (int)m_flip.size() ? m_flip[r][c] : 1.f);
-            float scaleY = 1.f;
-
-            // NEW: keep letters full size during the win celebration
-            if (m_win) { 
-                flip = 1.f; 
-                scaleY = 1.f; 
-            } else {
-                if (flip < 0.5f) scaleY = 1.f - (flip*2.f);
-                else             scaleY = (flip - 0.5f)*2.f;
-            }
 
-            ImVec4 drawCol = (flip < 0.5f ? colAbsent : fill);
-
-            ImGui::PushStyleColor(ImGuiCol_Button, drawCol);
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, drawCol);
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, drawCol);
-            ImGui::PushStyleColor(ImGuiCol_Border, colTileFrame);
-
-            ImGui::PushID(r*100 + c);
-            ImGui::Button("   ", ImVec2(m_tileSize, m_tileSize));
-            ImVec2 p = ImGui::GetItemRectMin();
-            ImVec2 s = ImGui::GetItemRectSize();
-
-            ImGui::PushClipRect(ImVec2(p.x, p.y), ImVec2(p.x + s.x, p.y + s.y), true);
-            ImGui::SetWindowFontScale(scaleY > 0.0f ? scaleY : 0.0001f);
-            
-            // Get the character to display
-            char ch = ' ';
-            if (r == m_rowIndex) {
-                // Current row - show what's being typed
-                if (c < (int)m_current.size()) {
-                    ch = m_current[c];
-                }
-            } else if (r < m_rowIndex) {
-                // Previous rows - show the guessed words
-                ch = m_rows[r][c];
-            }
-            
-            // Always render the character if it's valid
-            if (std::isalpha((unsigned char)ch)) {
-                // Center the text in the tile
-                float textWidth = 10.0f; // Approximate width of a single character
-                float textHeight = 20.0f; // Approximate height of a single character
-                float textX = p.x + (s.x - textWidth) * 0.5f;
-                float textY = p.y + (s.y - textHeight) * 0.5f;
-                
-                ImGui::SetCursorScreenPos(ImVec2(textX, textY));
-                
-                // Use white text for better visibility on all tile colors
-                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.96f, 0.97f, 1.0f, 1.0f));
-                ImGui::Text("%c", ch);
-                ImGui::PopStyleColor();
-            }
-            
-            ImGui::SetWindowFontScale(1.f);
-            ImGui::PopClipRect();
-            ImGui::PopID();
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    ImFont* font = ImGui::GetFont();
+    float fontSize = ImGui::GetFontSize();
+    ImVec2 origin = ImGui::GetWindowPos();
+
+    // animated "CIPHER" title, drawn straight from the string's bytes
+    if (m_core.boards() == 1) {
+        const char* text = m_titleText.data();
+        int shown = std::clamp(m_titleCharIndex, 0, (int)m_titleText.size());
+        float size = fontSize * 2.5f;
+        ImU32 col = ImGui::GetColorU32(ImVec4(0.8f, 0.8f, 1.0f, 1.0f)); // light blue
+        ImVec2 pos(origin.x + m_layout.title.x, origin.y + m_layout.title.y);
+        dl->AddText(font, size, pos, col, text, text + shown);
+        if (!m_titleBackspacing && shown < (int)m_titleText.size()) {
+            pos.x += font->CalcTextSizeA(size, FLT_MAX, 0.f, text, text + shown).x;
+            dl->AddText(font, size, pos, col, "|"); // cursor while typing
+        }
+    }
 
-            ImGui::PopStyleColor(4);
+    const ImU32 absent = ImGui::GetColorU32(colAbsent);
+    const ImU32 fills[3] = {absent, ImGui::GetColorU32(colPresent), ImGui::GetColorU32(colCorrect)};
+    const ImU32 frame = ImGui::GetColorU32(colTileFrame);
+    const ImU32 letter = ImGui::GetColorU32(ImVec4(0.96f, 0.97f, 1.0f, 1.0f));
+    const float tile = m_layout.tile;
+    const float rounding = tile * 0.125f;
+    // tiny tiles (dozens of boards) skip borders and glyphs
+    const bool detail = tile >= 12.f;
+    const float glyphScale = std::min(1.f, tile / m_tileSize * 2.f);
+    const int rows = m_core.rows();
+    const int cur = m_core.rowIndex();
+
+    for (int b=0;b<m_core.boards();++b) {
+        const ImVec2 bo(origin.x + m_layout.origins[b].x, origin.y + m_layout.origins[b].y);
+        const int solved = m_core.solvedAt(b);
+        const int last = solved >= 0 ? solved : cur; // rows after a solve stay blank
+        const float* flips = m_flip.data() + (size_t)b * rows * cfg.length;
+
+        for (int r=0;r<rows;++r) {
+            const TileState* states = m_core.rowStates(r, b);
+            const std::string* word = nullptr;
+            if (r == cur && solved < 0) word = &m_core.current();
+            else if (r < cur && r <= last) word = &m_core.row(r);
+
+            for (int c=0;c<cfg.length;++c) {
+                const ImVec2& at = m_layout.tiles[(size_t)r * cfg.length + c];
+                ImVec2 p(bo.x + at.x, bo.y + at.y);
+                ImVec2 q(p.x + tile, p.y + tile);
+
+                float flip = flips[(size_t)r * cfg.length + c];
+                float scale = 1.f;
+                // keep letters full size during the win celebration
+                if (m_core.won()) flip = 1.f;
+                else scale = flip < 0.5f ? 1.f - flip * 2.f : (flip - 0.5f) * 2.f;
+
+                dl->AddRectFilled(p, q, flip < 0.5f ? absent : fills[(int)states[c]], rounding);
+                if (!detail) continue;
+                dl->AddRect(p, q, frame, rounding);
+
+                if (!word || c >= (int)word->size()) continue;
+                const char* ch = word->data() + c;
+                if (!std::isalpha((unsigned char)*ch) || scale <= 0.f) continue;
+                float size = fontSize * scale * glyphScale;
+                ImVec2 glyph = font->CalcTextSizeA(size, FLT_MAX, 0.f, ch, ch + 1);
+                dl->AddText(font, size, ImVec2(p.x + (tile - glyph.x) * 0.5f, p.y + (tile - glyph.y) * 0.5f),
+                            letter, ch, ch + 1);
+            }
         }
     }
-    
+
     // Move cursor to end of board for next element
-    ImGui::SetCursorPos(ImVec2(0, startY + boardHeight));
-    
-    ImGui::PopStyleVar(2);
+    ImGui::SetCursorPos(m_layout.boardEnd);
 }
 
 void Game::drawKeyboard() {
     ImGui::Dummy(ImVec2(0, 8));
-    
-    // Calculate keyboard dimensions for centering - make keys bigger
-    float keyWidth = 48.f;  // Increased from 36.f
-    float keyHeight = 56.f; // Increased from 42.f
-    float keyGap = 8.f;     // Increased from 6.f
-    
-    for (int ri=0; ri<3; ++ri) {
-        const char* row = kbdRows[ri];
-        int n = (int)std::strlen(row);
-        
-        // Calculate row width and center it
-        float rowWidth = n * keyWidth + (n - 1) * keyGap;
-        float availWidth = ImGui::GetContentRegionAvail().x;
-        float startX = (availWidth - rowWidth) * 0.5f;
-        
-        // Add centering spacer
-        if (startX > 0) {
-            ImGui::Dummy(ImVec2(startX, 0));
-            ImGui::SameLine();
-        }
-        
-        for (int i=0;i<n;++i) {
-            char ch = row[i];
-            int idx = ch - 'A';
-            float a = m_keyAnim[idx];
+
+    float width = ImGui::GetContentRegionAvail().x;
+    if (width != m_layout.keysWidth || m_core.boards() != m_layout.keysBoards) layoutKeyboard(width);
+
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    ImFont* font = ImGui::GetFont();
+    float fontSize = ImGui::GetFontSize();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImU32 text = ImGui::GetColorU32(ImGuiCol_Text);
+    static const char letters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    // several boards split each key into a grid of cells, one per board
+    const int boards = m_core.boards();
+    const int cellCols = (int)std::ceil(std::sqrt((float)boards));
+    const int cellRows = (boards + cellCols - 1) / cellCols;
+    const ImVec2 cell(m_keySize.x / cellCols, m_keySize.y / cellRows);
+    const float rounding = boards == 1 ? ImGui::GetStyle().FrameRounding : 0.f;
+
+    for (int idx=0; idx<26; ++idx) {
+        ImVec2 p(origin.x + m_layout.keys[idx].x, origin.y + m_layout.keys[idx].y);
+        for (int b=0;b<boards;++b) {
+            float a = m_keyAnim[b * 26 + idx];
+            int state = m_core.keyState(idx, b);
             ImVec4 target;
-            if (m_keyState[idx] == 2) {
+            if (state == 2) {
                 target = colCorrect;
-            } else if (m_keyState[idx] == 1) {
+            } else if (state == 1) {
                 target = colPresent;
-            } else if (m_keyState[idx] == -1) {
+            } else if (state == -1) {
                 target = colWrong; // Red for wrong letters
             } else {
                 target = colAbsent; // Default gray for unused letters
@@ -440,25 +383,30 @@ void Game::drawKeyboard() {
                                  base.y + (target.y-base.y)*a,
                                  base.z + (target.z-base.z)*a,
                                  1.0f);
-            ImGui::PushStyleColor(ImGuiCol_Button, fill);
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, fill);
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, fill);
-            ImGui::Button(std::string(1, ch).c_str(), ImVec2(keyWidth, keyHeight));
-            ImGui::PopStyleColor(3);
-            if (i+1<n) ImGui::SameLine(0, keyGap);
+            ImVec2 c0(p.x + (b % cellCols) * cell.x, p.y + (b / cellCols) * cell.y);
+            dl->AddRectFilled(c0, ImVec2(c0.x + cell.x, c0.y + cell.y), ImGui::GetColorU32(fill), rounding);
         }
-        if (ri < 2) ImGui::Dummy(ImVec2(0, 6)); // Increased spacing between rows
+        if (boards > 1) dl->AddRect(p, ImVec2(p.x + m_keySize.x, p.y + m_keySize.y), ImGui::GetColorU32(colTileFrame));
+
+        const char* ch = letters + idx;
+        ImVec2 glyph = font->CalcTextSizeA(fontSize, FLT_MAX, 0.f, ch, ch + 1);
+        dl->AddText(font, fontSize, ImVec2(p.x + (m_keySize.x - glyph.x) * 0.5f, p.y + (m_keySize.y - glyph.y) * 0.5f),
+                    text, ch, ch + 1);
     }
+
+    // reserve the keyboard's space so the footer lays out below it
+    ImGui::Dummy(m_layout.keysSize);
 }
 
 void Game::topMenu() {
+    GameConfig cfg = m_core.config();
     if (ImGui::BeginMainMenuBar()) {
         if (ImGui::BeginMenu("game")) {
             if (ImGui::MenuItem("new random")) {
-                m_cfg.daily = false; newGame(m_cfg);
+                cfg.daily = false; newGame(cfg);
             }
             if (ImGui::MenuItem("new daily")) {
-                m_cfg.daily = true; newGame(m_cfg);
+                cfg.daily = true; newGame(cfg);
             }
             if (ImGui::MenuItem("restart (same word)")) {
                 restart();
@@ -470,24 +418,39 @@ void Game::topMenu() {
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("settings")) {
-            int len = m_cfg.length;
+            int len = cfg.length;
             if (ImGui::SliderInt("word Length", &len, 4, 6)) {
-                if (len != m_cfg.length) {
-                    m_cfg.length = len;
-                    newGame(m_cfg);
+                if (len != cfg.length) {
+                    cfg.length = len;
+                    newGame(cfg);
                 }
             }
-            int att = m_cfg.attempts;
+            int att = cfg.attempts;
             if (ImGui::SliderInt("attempts", &att, 4, 8)) {
-                if (att != m_cfg.attempts) {
-                    m_cfg.attempts = att;
-                    newGame(m_cfg);
+                if (att != cfg.attempts) {
+                    cfg.attempts = att;
+                    newGame(cfg);
                 }
             }
-            bool strict = !m_lenient;
+            int boards = cfg.boards;
+            if (ImGui::SliderInt("boards", &boards, 1, GameState::kMaxBoards)) {
+                if (boards != cfg.boards) {
+                    cfg.boards = boards;
+                    newGame(cfg);
+                }
+            }
+            bool adversarial = cfg.adversarial;
+            if (ImGui::Checkbox("adversarial (absurdle)", &adversarial)) {
+                cfg.adversarial = adversarial;
+                newGame(cfg);
+            }
+            bool strict = !m_core.lenient();
             if (ImGui::Checkbox("strict dictionary", &strict)) {
-                m_lenient = !strict;
+                setLenient(!strict);
             }
+            ImGui::Checkbox("suggestions", &m_suggest);
+            if (m_core.hasBook()) ImGui::Checkbox("hint book", &m_bookHints);
+            else ImGui::TextDisabled("hint book: run cipher-book");
             ImGui::EndMenu();
         }
         ImGui::EndMainMenuBar();
@@ -495,49 +458,92 @@ void Game::topMenu() {
 }
 
 void Game::footer() {
+    const Stats& stats = m_core.stats();
+    const GameConfig& cfg = m_core.config();
     ImGui::Dummy(ImVec2(0, 8)); // Add spacing after keyboard
     ImGui::Separator();
-    ImGui::TextDisabled("cipher clue:");
-    ImGui::SameLine();
-    ImGui::Text("%s", m_cipherClue.c_str());
+    // absurdle has no fixed secret until the end, so no clue or hints
+    if (cfg.adversarial) {
+        ImGui::TextDisabled("adversarial: the secret dodges every guess");
+    } else {
+        ImGui::TextDisabled("cipher clue:");
+        ImGui::SameLine();
+        ImGui::Text("%s", m_core.cipherClue().c_str());
+    }
 
-    int used = m_rowIndex;
-    if (!m_win && !m_outOfAttempts) {
+    // words still consistent with the board, plus a few of them
+    const CandidateSet& cands = m_core.candidates();
+    if (m_core.boards() > 1) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("  |  boards solved %d/%d", m_core.solvedCount(), m_core.boards());
+    } else if (m_core.rowIndex() > 0 && !m_core.won()) {
+        const Dictionary& dict = m_core.dictionary();
+        size_t idx[6];
+        size_t shown = cands.sample(6, idx);
+        char sample[64];
+        int n = 0;
+        for (size_t i=0; i<shown; ++i) {
+            std::string_view w = dict[idx[i]];
+            n += std::snprintf(sample + n, sizeof(sample) - n, "%s%.*s", i ? " " : "", (int)w.size(), w.data());
+        }
+        if (cands.count() > shown) std::snprintf(sample + n, sizeof(sample) - n, " ...");
+        else if (shown == 0) std::snprintf(sample, sizeof(sample), "-");
+        ImGui::SameLine();
+        ImGui::TextDisabled("  |  %zu left: %s", cands.count(), sample);
+    }
+
+    if (m_suggest && !m_core.finished()) suggestionStrip();
+
+    int used = m_core.rowIndex();
+    if (!cfg.adversarial && !m_core.won() && !m_core.outOfAttempts()) {
         if (used >= 2) {
-            ImGui::TextDisabled("hint: key parity: %s", (m_caesarKey % 2 == 0) ? "even" : "odd");
+            ImGui::TextDisabled("hint: key parity: %s", (m_core.caesarKey() % 2 == 0) ? "even" : "odd");
         }
         if (used >= 3) {
-            ImGui::TextDisabled("hint: key k = %d", m_caesarKey);
+            ImGui::TextDisabled("hint: key k = %d", m_core.caesarKey());
         }
-        if (used >= 4) {
+        if (m_bookHints && m_core.hasBook()) {
+            std::string_view next = m_core.bookHint();
+            if (next.empty()) ImGui::TextDisabled("hint book: off the book");
+            else ImGui::TextDisabled("hint book: try %.*s", (int)next.size(), next.data());
+        }
+        if (used >= cfg.hintFrom) {
             ImGui::TextDisabled("revealed letters:");
             ImGui::SameLine();
-            std::string rev;
-            for (int i=0;i<m_cfg.length;++i) {
-                rev.push_back(m_revealMask[i] ? m_secret[i] : '_');
-                if (i+1 < m_cfg.length) rev.push_back(' ');
+            char rev[2 * WordCodes::kMaxLength];
+            int n = 0;
+            for (int i=0;i<cfg.length;++i) {
+                rev[n++] = m_core.revealed(i) ? m_core.secret()[i] : '_';
+                rev[n++] = i+1 < cfg.length ? ' ' : '\0';
             }
-            ImGui::Text("%s", rev.c_str());
+            ImGui::Text("%s", rev);
         }
     }
 
-    if (m_win) {
+    if (m_core.won()) {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.6f, 1.0f, 0.6f, 1.0f));
-        ImGui::Text("wow you solved it in %d/%d!", m_rowIndex, m_cfg.attempts);
+        ImGui::Text("wow you solved it in %d/%d!", m_core.rowIndex(), m_core.rows());
         ImGui::PopStyleColor();
-    } else if (m_outOfAttempts) {
+    } else if (m_core.outOfAttempts()) {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.6f, 0.6f, 1.0f));
-        ImGui::Text("sorry, you're out of attempts. the word was: %s (k=%d)", m_secret.c_str(), m_caesarKey);
+        if (m_core.boards() > 1)
+            ImGui::Text("sorry, you're out of attempts. %d/%d boards solved", m_core.solvedCount(), m_core.boards());
+        else
+            ImGui::Text("sorry, you're out of attempts. the word was: %s (k=%d)", m_core.secret().c_str(), m_core.caesarKey());
         ImGui::PopStyleColor();
     }
 
     ImGui::TextDisabled("session: played %d, wins %d, streak %d/%d",
-        m_stats.total, m_stats.wins, m_stats.currentStreak, m_stats.maxStreak);
+        stats.total, stats.wins, stats.currentStreak, stats.maxStreak);
+    if (m_journal) {
+        ImGui::TextDisabled("all time: played %d, wins %d, streak %d/%d",
+            m_allTime.total, m_allTime.wins, m_allTime.currentStreak, m_allTime.maxStreak);
+    }
 
-    if (m_msgTimer > 0.f && !m_msg.empty()) {
+    if (m_msgTimer > 0.f && m_msg[0]) {
         ImGui::Separator();
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.f, 0.6f, 0.6f, 1.f));
-        ImGui::TextWrapped("%s", m_msg.c_str());
+        ImGui::TextWrapped("%s", m_msg);
         ImGui::PopStyleColor();
     }
     
@@ -545,7 +551,34 @@ void Game::footer() {
     ImGui::Dummy(ImVec2(0, 10));
 }
 
+void Game::suggestionStrip() {
+    if (m_suggestDirty) {
+        m_suggestTotal = m_core.suggestions(m_suggestIdx, kSuggestions);
+        m_suggestDirty = false;
+    }
+    const size_t shown = std::min<size_t>(m_suggestTotal, kSuggestions);
+    ImGui::TextDisabled("fits (%zu):", m_suggestTotal);
+    const Dictionary& dict = m_core.dictionary();
+    for (size_t i=0; i<shown; ++i) {
+        std::string_view w = dict[m_suggestIdx[i]];
+        char label[WordCodes::kMaxLength + 1];
+        std::snprintf(label, sizeof(label), "%.*s", (int)w.size(), w.data());
+        ImGui::SameLine();
+        ImGui::PushID((int)i);
+        if (ImGui::SmallButton(label)) typeWord(w);
+        ImGui::PopID();
+    }
+    if (m_suggestTotal > shown) { ImGui::SameLine(); ImGui::TextDisabled("..."); }
+}
+
+void Game::typeWord(std::string_view word) {
+    while (!m_core.current().empty() && onKeyPressed(sf::Keyboard::Backspace)) {}
+    for (char c : word) onTextEntered((sf::Uint32)(unsigned char)c);
+}
+
 void Game::renderUI() {
+    const Stats& stats = m_journal ? m_allTime : m_core.stats();
+    const GameConfig& cfg = m_core.config();
     ImGui::PushStyleColor(ImGuiCol_WindowBg, colBg);
     ImGui::Begin("##root", nullptr,
         ImGuiWindowFlags_NoDecoration |
@@ -557,11 +590,11 @@ void Game::renderUI() {
 
     topMenu();
     ImGui::SetCursorPos(ImVec2(10, 26));
-    ImGui::TextDisabled("mode: %s  |  streak: %d/%d", (m_cfg.daily? "daily":"random"), m_stats.currentStreak, m_stats.maxStreak);
+    ImGui::TextDisabled("mode: %s  |  streak: %d/%d", (cfg.daily? "daily":"random"), stats.currentStreak, stats.maxStreak);
 
     ImVec2 display = ImGui::GetIO().DisplaySize;
-    float boardW = m_cfg.length * m_tileSize + (m_cfg.length - 1) * m_tileGap;
-    float boardH = m_cfg.attempts * m_tileSize + (m_cfg.attempts - 1) * m_tileGap;
+    float boardW = cfg.length * m_tileSize + (cfg.length - 1) * m_tileGap;
+    float boardH = m_core.rows() * m_tileSize + (m_core.rows() - 1) * m_tileGap;
     float footerH = 260.f; // Slightly reduced to prevent cutoff
     float bottomMargin = 30.f; // Increased bottom margin for better spacing
 
@@ -573,13 +606,22 @@ void Game::renderUI() {
     if (startX < 10.f) startX = 10.f;
 
     ImGui::SetCursorPos(ImVec2(startX, startY));
-    drawBoard();
+    {
+        FrameProfiler::Scope scope(m_prof, FrameProfiler::DrawBoard);
+        drawBoard();
+    }
 
     float footerW = 800.f; // Increased width to accommodate bigger keyboard
     ImGui::SetCursorPos(ImVec2((display.x - footerW) * 0.5f, display.y - footerH - bottomMargin));
     ImGui::BeginChild("footer", ImVec2(footerW, footerH - 10.f), true);
-    drawKeyboard();
-    footer();
+    {
+        FrameProfiler::Scope scope(m_prof, FrameProfiler::DrawKeyboard);
+        drawKeyboard();
+    }
+    {
+        FrameProfiler::Scope scope(m_prof, FrameProfiler::Footer);
+        footer();
+    }
     ImGui::EndChild();
 
     ImGui::End();
@@ -1,44 +1,24 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <imgui.h>
+#include "GameState.hpp"
+#include "FrameProfiler.hpp"
+#include "InputLog.hpp"
+#include "StatsJournal.hpp"
+#include "Tweens.hpp"
+#include <random>
 #include <string>
 #include <vector>
-#include <unordered_set>
-#include <random>
-
-enum class TileState : int { Absent = 0, Present = 1, Correct = 2 };
-
-struct Stats {
-    int total = 0, wins = 0;
-    int currentStreak = 0, maxStreak = 0;
-    std::vector<int> distribution; // 1..N attempts
-    Stats() : distribution(10, 0) {}
-    void record(bool win, int attemptsUsed) {
-        total++;
-        if (win) {
-            wins++; currentStreak++;
-            if (currentStreak > maxStreak) maxStreak = currentStreak;
-            if (attemptsUsed >= 1 && attemptsUsed <= (int)distribution.size())
-                distribution[attemptsUsed - 1]++;
-        } else {
-            currentStreak = 0;
-        }
-    }
-};
-
-struct GameConfig {
-    int length = 5;     // word length (4-6 recommended)
-    int attempts = 6;   // total rows
-    bool daily = false; // daily or random
-};
 
 class Game {
 public:
-    explicit Game();
+    explicit Game(uint64_t seed = std::random_device{}());
 
     // lifecycle
     void newGame(const GameConfig& cfg);
     void restart();
+    void setLenient(bool lenient);
+    void setDailySeed(uint64_t seed) { m_core.setDailySeed(seed); }
 
     // input
     bool onTextEntered(sf::Uint32 unicode);
@@ -48,76 +28,106 @@ public:
     void update(float dt);
     void renderUI();
 
+    // seconds until the next frame has to be drawn: 0 while something is
+    // animating, +inf when the screen only changes on input
+    float redrawIn() const;
+    void noteActivity() { m_idleTime = 0.f; }
+
+    // optional; renderUI times its board/keyboard/footer sections into it
+    void setProfiler(FrameProfiler* prof) { m_prof = prof; }
+    // optional; every input, menu action and frame dt is appended to it
+    void setRecorder(InputLog* log) { m_log = log; }
+    // optional; finished games are appended to it and the footer adds the
+    // all-time stats it was opened with
+    void setJournal(StatsJournal* journal);
+    uint64_t stateHash() const { return m_core.stateHash(); }
+
     // expose
-    const GameConfig& config() const { return m_cfg; }
-    int currentStreak() const { return m_stats.currentStreak; }
-    int maxStreak() const { return m_stats.maxStreak; }
+    const GameConfig& config() const { return m_core.config(); }
+    // rules state behind the UI, for tools that script a board
+    const GameState& core() const { return m_core; }
+    int currentStreak() const { return m_core.stats().currentStreak; }
+    int maxStreak() const { return m_core.stats().maxStreak; }
     bool wantsToQuit() const { return m_wantsToQuit; }
 
 private:
-    // helpers
-    static std::string toUpper(const std::string& s);
-    static bool isAlpha(const std::string& s);
-    static char caesarShiftChar(char c, int k);
-    static std::string caesarShift(const std::string& s, int k);
-    static uint64_t dailySeed(); // days since epoch
-
-    void pickSecret();
-    std::vector<TileState> evaluate(const std::string& guess) const;
-    void pushHintProgression();
-
     // drawing helpers
+    void resetAnimations();
     void drawBoard();
     void drawKeyboard();
+    void layoutBoard(const ImVec2& window);
+    void layoutKeyboard(float width);
+    // one title letter typed or erased; reschedules itself until parked
+    void advanceTitle();
+    static void titleStep(void* game, uint32_t);
     void topMenu();
     void footer();
+    void suggestionStrip();
+    // replaces the current row through the input handlers, so recordings
+    // replay it like typing
+    void typeWord(std::string_view word);
 
 private:
-    GameConfig m_cfg{};
-    bool m_lenient = true; // allow guesses not in dictionary
+    GameState m_core; // rules, dictionary, hints, stats
     float m_msgTimer = 0.f;
-    std::string m_msg;
-    std::vector<std::string> m_dict; // candidates
-    std::unordered_set<std::string> m_valid; // quick membership
-    std::string m_secret;
-
-    // guesses
-    std::vector<std::string> m_rows;
-    std::vector<std::vector<TileState>> m_states;
-    int m_rowIndex = 0;
-    std::string m_current;
-
-    // hints
-    int m_caesarKey = 0;
-    std::string m_cipherClue;
-    std::vector<bool> m_revealMask;
-
-    // rng
-    std::mt19937_64 m_rng;
-
-    // keyboard heatmap targets [0..2] and animated value [0..1]
-    int   m_keyState[26] = {0};      // 0 absent, 1 present, 2 correct (target)
-    float m_keyAnim[26]  = {0.f};    // animated brightness 0..1
-
-    // tile flip animation per guess row
-    std::vector<std::vector<float>> m_flip; // 0..1 progress per tile
+    char m_msg[64] = {};
+
+    // only the values currently moving (flips, key fades) plus the title's
+    // next step; update() and redrawIn() never scan idle tiles or keys
+    Tweens m_tweens;
+
+    // keyboard heatmap animated value [0..1] per [board][letter];
+    // targets live in m_core
+    std::vector<float> m_keyAnim;
+
+    // tile flip animation, flat [board][row][tile] like GameState's states
+    std::vector<float> m_flip;              // 0..1 progress per tile
     float m_flipSpeed = 6.f;                // higher = faster
 
     // title typing animation
-    float m_titleAnimTimer = 0.f;
     int m_titleCharIndex = 0;
     bool m_titleBackspacing = false;
+    bool m_titleParked = false;             // full word shown, no step scheduled
     std::string m_titleText = "CIPHER";
-
-    // session stats
-    Stats m_stats;
+    float m_titleIdleAfter = 10.f;          // pause the title after this much inactivity
+    float m_idleTime = 0.f;                 // seconds since the last input
 
     // layout cache
     float m_tileSize = 64.f;
     float m_tileGap = 10.f;
+    ImVec2 m_keySize = ImVec2(48.f, 56.f);
+    float m_keyGap = 8.f;
+    float m_keyRowGap = 14.f;
+
+    // tile/key rectangles, window-relative; only rebuilt when the
+    // window size or board shape changes so drawing is just quads + glyphs
+    struct Layout {
+        ImVec2 window = ImVec2(-1.f, -1.f);
+        int length = 0, rows = 0, boards = 0;
+        float tile = 0.f;             // tile edge; shrinks to fit many boards
+        ImVec2 title;                 // title baseline origin
+        ImVec2 boardEnd;              // cursor after the board
+        std::vector<ImVec2> origins;  // top-left per board
+        std::vector<ImVec2> tiles;    // per tile offset from its board's origin, row-major
+        float keysWidth = -1.f;
+        int keysBoards = 0;
+        ImVec2 keys[26];              // top-left per letter, keyboard-relative
+        ImVec2 keysSize;
+    } m_layout;
 
     // status
-    bool m_win = false;
-    bool m_outOfAttempts = false;
     bool m_wantsToQuit = false;
+    bool m_bookHints = false; // show the hint book's next guess in the footer
+    bool m_suggest = true;    // strip of dictionary words that fit the row being typed
+
+    // suggestion strip, recomputed only after input changes the board
+    static constexpr int kSuggestions = 8;
+    size_t m_suggestIdx[kSuggestions] = {};
+    size_t m_suggestTotal = 0;
+    bool m_suggestDirty = true;
+
+    FrameProfiler* m_prof = nullptr;
+    InputLog* m_log = nullptr;
+    StatsJournal* m_journal = nullptr;
+    Stats m_allTime; // journal history + this session
 };
@@ -0,0 +1,310 @@
+#include "GameServer.hpp"
+#include "Pattern.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // epoll user data for the non-session fds
+    char kStopTag, kTcpTag, kUnixTag;
+
+    constexpr int kMaxEvents = 256;
+    constexpr size_t kReadChunk = 4096;
+}
+
+struct GameServer::Session {
+    Session(int f, uint64_t seed) : fd(f), game(seed) {}
+    int fd;
+    GameState game;
+    std::vector<uint8_t> in;   // bytes of an incomplete request
+    std::vector<uint8_t> out;  // replies not yet written
+    size_t outAt = 0;
+    bool wantWrite = false;    // EPOLLOUT registered
+    bool closing = false;      // close once `out` is written
+};
+
+struct GameServer::Worker {
+    ~Worker() {
+        for (auto& [fd, s] : sessions) ::close(fd);
+        if (epoll >= 0) ::close(epoll);
+    }
+    int epoll = -1;
+    std::unordered_map<int, std::unique_ptr<Session>> sessions;
+    std::mt19937_64 rng;
+    std::thread thread;
+};
+
+GameServer::GameServer() = default;
+
+GameServer::~GameServer() {
+    stop();
+    for (auto& w : m_workers) if (w->thread.joinable()) w->thread.join();
+    m_workers.clear();
+    if (m_tcp >= 0) ::close(m_tcp);
+    if (m_unix >= 0) { ::close(m_unix); ::unlink(m_opt.unixPath.c_str()); }
+    if (m_stopFd >= 0) ::close(m_stopFd);
+}
+
+bool GameServer::start(const Options& opt, std::string& error) {
+    m_opt = opt;
+    m_opt.threads = std::max(1, opt.threads);
+
+    // load every length once; sessions share them read-only
+    m_proto.setWordsPath(opt.wordsPath);
+    for (int len=4; len<=6; ++len) {
+        GameConfig cfg;
+        cfg.length = len;
+        m_proto.newGame(cfg);
+    }
+
+    m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_stopFd < 0) { error = "eventfd: " + std::string(std::strerror(errno)); return false; }
+
+    if (opt.port >= 0) {
+        m_tcp = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int one = 1;
+        ::setsockopt(m_tcp, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)opt.port);
+        if (::inet_pton(AF_INET, opt.host.c_str(), &addr.sin_addr) != 1) { error = "bad host " + opt.host; return false; }
+        if (m_tcp < 0 || ::bind(m_tcp, (sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(m_tcp, SOMAXCONN) != 0) {
+            error = "tcp " + opt.host + ":" + std::to_string(opt.port) + ": " + std::strerror(errno);
+            return false;
+        }
+        socklen_t len = sizeof(addr);
+        ::getsockname(m_tcp, (sockaddr*)&addr, &len);
+        m_port = ntohs(addr.sin_port);
+    }
+    if (!opt.unixPath.empty()) {
+        sockaddr_un addr{};
+        if (opt.unixPath.size() >= sizeof(addr.sun_path)) { error = "unix socket path too long"; return false; }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, opt.unixPath.c_str(), opt.unixPath.size() + 1);
+        ::unlink(opt.unixPath.c_str());
+        m_unix = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_unix < 0 || ::bind(m_unix, (sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(m_unix, SOMAXCONN) != 0) {
+            error = "unix " + opt.unixPath + ": " + std::strerror(errno);
+            return false;
+        }
+    }
+    if (m_tcp < 0 && m_unix < 0) { error = "no listener (TCP disabled and no Unix socket)"; return false; }
+
+    std::random_device rd;
+    uint64_t seed = opt.seed ? opt.seed : ((uint64_t)rd() << 32 | rd());
+    for (int t=0; t<m_opt.threads; ++t) {
+        auto w = std::make_unique<Worker>();
+        w->rng.seed(seed + 0x9E3779B97F4A7C15ull * (uint64_t)t);
+        w->epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if (w->epoll < 0) { error = "epoll_create1: " + std::string(std::strerror(errno)); return false; }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = &kStopTag;
+        ::epoll_ctl(w->epoll, EPOLL_CTL_ADD, m_stopFd, &ev);
+        ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+        if (m_tcp >= 0) { ev.data.ptr = &kTcpTag; ::epoll_ctl(w->epoll, EPOLL_CTL_ADD, m_tcp, &ev); }
+        if (m_unix >= 0) { ev.data.ptr = &kUnixTag; ::epoll_ctl(w->epoll, EPOLL_CTL_ADD, m_unix, &ev); }
+        m_workers.push_back(std::move(w));
+    }
+    return true;
+}
+
+void GameServer::run() {
+    for (size_t t=1; t<m_workers.size(); ++t) m_workers[t]->thread = std::thread([this, t] { loop(*m_workers[t]); });
+    if (!m_workers.empty()) loop(*m_workers[0]);
+    for (auto& w : m_workers) if (w->thread.joinable()) w->thread.join();
+}
+
+void GameServer::stop() {
+    if (m_stopFd < 0) return;
+    uint64_t one = 1;
+    // level-triggered and never read, so every worker sees it
+    [[maybe_unused]] ssize_t n = ::write(m_stopFd, &one, sizeof(one));
+}
+
+void GameServer::loop(Worker& w) {
+    epoll_event events[kMaxEvents];
+    for (;;) {
+        int n = ::epoll_wait(w.epoll, events, kMaxEvents, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        for (int i=0; i<n; ++i) {
+            void* tag = events[i].data.ptr;
+            if (tag == &kStopTag) return;
+            if (tag == &kTcpTag) { acceptAll(w, m_tcp); continue; }
+            if (tag == &kUnixTag) { acceptAll(w, m_unix); continue; }
+            // only this session's own event can close it, so the pointer is live
+            Session& s = *(Session*)tag;
+            if (events[i].events & (EPOLLHUP | EPOLLERR)) { closeSession(w, s); continue; }
+            if (events[i].events & EPOLLIN) {
+                readFrom(w, s);
+                continue; // readFrom already flushed or closed
+            }
+            if (events[i].events & EPOLLOUT) flushOut(w, s);
+        }
+    }
+}
+
+void GameServer::acceptAll(Worker& w, int listenFd) {
+    for (;;) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return; // EAGAIN: another worker took it, or the backlog is empty
+        if (listenFd == m_tcp) {
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        auto s = std::make_unique<Session>(fd, w.rng());
+        s->game.shareWords(m_proto);
+        s->game.newGame(GameConfig{});
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = s.get();
+        if (::epoll_ctl(w.epoll, EPOLL_CTL_ADD, fd, &ev) != 0) { ::close(fd); continue; }
+        w.sessions.emplace(fd, std::move(s));
+        m_counters.accepted.fetch_add(1, std::memory_order_relaxed);
+        m_counters.open.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GameServer::readFrom(Worker& w, Session& s) {
+    uint8_t buf[kReadChunk];
+    bool eof = false;
+    for (;;) {
+        ssize_t got = ::recv(s.fd, buf, sizeof(buf), 0);
+        if (got > 0) { s.in.insert(s.in.end(), buf, buf + got); continue; }
+        if (got == 0) eof = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) eof = true;
+        break;
+    }
+
+    size_t at = 0;
+    while (!s.closing) {
+        size_t n = Protocol::complete(s.in.data() + at, s.in.size() - at);
+        if (n == 0) break;
+        handle(s, s.in.data() + at, n);
+        at += n;
+    }
+    s.in.erase(s.in.begin(), s.in.begin() + (ptrdiff_t)at);
+
+    if (eof && s.out.size() == s.outAt) { closeSession(w, s); return; }
+    flushOut(w, s);
+}
+
+void GameServer::handle(Session& s, const uint8_t* msg, size_t n) {
+    m_counters.requests.fetch_add(1, std::memory_order_relaxed);
+    GameState& g = s.game;
+    const uint8_t* payload = msg + Protocol::kHeader;
+    const size_t len = n - Protocol::kHeader;
+    uint8_t reply[Protocol::kMaxMessage];
+    size_t size = 0;
+
+    switch ((Protocol::Op)msg[0]) {
+    case Protocol::NewGame: {
+        Protocol::Reader r(payload, len);
+        GameConfig cfg;
+        cfg.length = r.u8();
+        cfg.attempts = std::clamp<int>(r.u8(), 1, GameState::kMaxAttempts);
+        cfg.boards = r.u8();
+        uint8_t flags = r.u8();
+        if (!r.ok()) break;
+        cfg.daily = (flags & Protocol::kDaily) != 0;
+        cfg.adversarial = (flags & Protocol::kAdversarial) != 0;
+        g.newGame(cfg); // clamps length and boards
+        size = Protocol::Writer(reply, Protocol::NewGame)
+            .u8((uint8_t)g.config().length).u8((uint8_t)g.rows()).u8((uint8_t)g.boards())
+            .u32((uint32_t)g.candidates().count()).finish();
+        break;
+    }
+    case Protocol::Guess: {
+        while (g.backspace()) {} // drop letters of a rejected guess
+        // typeLetter() would drop the letters of an over-long payload and
+        // submit its prefix; a guess of the wrong length types nothing and
+        // comes back TooShort
+        if (len == (size_t)g.config().length)
+            for (size_t i=0; i<len; ++i) g.typeLetter((char)payload[i]);
+        const int row = g.rowIndex();
+        SubmitResult res = g.submit();
+        Protocol::Status status = g.won() ? Protocol::Won : (g.outOfAttempts() ? Protocol::Lost : Protocol::Playing);
+        const int boards = res == SubmitResult::Accepted ? g.boards() : 0;
+        Protocol::Writer out(reply, Protocol::Guess);
+        out.u8((uint8_t)res).u8(status).u8((uint8_t)boards);
+        for (int b=0; b<boards; ++b) out.u16(Patterns::encode(g.rowStates(row, b), g.config().length));
+        size = out.u32((uint32_t)g.candidates().count()).finish();
+        if (res == SubmitResult::Accepted && status != Protocol::Playing)
+            m_counters.games.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+    case Protocol::Stats: {
+        const Stats& st = g.stats();
+        size = Protocol::Writer(reply, Protocol::Stats)
+            .u32((uint32_t)st.total).u32((uint32_t)st.wins)
+            .u32((uint32_t)st.currentStreak).u32((uint32_t)st.maxStreak).finish();
+        break;
+    }
+    case Protocol::Quit:
+        size = Protocol::Writer(reply, Protocol::Quit).finish();
+        s.closing = true;
+        break;
+    default:
+        break;
+    }
+    if (size == 0) {
+        static const char kBad[] = "malformed request";
+        size = Protocol::Writer(reply, Protocol::Error).bytes(kBad, sizeof(kBad) - 1).finish();
+        s.closing = true;
+    }
+    s.out.insert(s.out.end(), reply, reply + size);
+}
+
+void GameServer::flushOut(Worker& w, Session& s) {
+    while (s.outAt < s.out.size()) {
+        ssize_t sent = ::send(s.fd, s.out.data() + s.outAt, s.out.size() - s.outAt, MSG_NOSIGNAL);
+        if (sent > 0) { s.outAt += (size_t)sent; continue; }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!s.wantWrite) {
+                epoll_event ev{};
+                ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+                ev.data.ptr = &s;
+                ::epoll_ctl(w.epoll, EPOLL_CTL_MOD, s.fd, &ev);
+                s.wantWrite = true;
+            }
+            return;
+        }
+        closeSession(w, s);
+        return;
+    }
+    s.out.clear();
+    s.outAt = 0;
+    if (s.closing) { closeSession(w, s); return; }
+    if (s.wantWrite) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = &s;
+        ::epoll_ctl(w.epoll, EPOLL_CTL_MOD, s.fd, &ev);
+        s.wantWrite = false;
+    }
+}
+
+void GameServer::closeSession(Worker& w, Session& s) {
+    int fd = s.fd;
+    ::epoll_ctl(w.epoll, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    w.sessions.erase(fd); // destroys `s`
+    m_counters.open.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "GameState.hpp"
+#include "Protocol.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Hosts one GameState per connection over TCP (loopback by default) and/or a
+// Unix socket, speaking Protocol. Every worker thread runs its own
+// non-blocking epoll loop; the listening sockets sit in all of them with
+// EPOLLEXCLUSIVE, so one worker wakes per new connection and the session
+// stays on it. Sessions share the word lists loaded once at start().
+// Linux only.
+class GameServer {
+public:
+    struct Options {
+        std::string host = "127.0.0.1";
+        int port = Protocol::kDefaultPort;   // -1 = no TCP listener, 0 = any free port
+        std::string unixPath;                // empty = no Unix socket
+        int threads = 1;
+        std::string wordsPath = "assets/words.txt";
+        uint64_t seed = 0;                   // session seeds; 0 = random
+    };
+    struct Counters {
+        std::atomic<uint64_t> accepted{0}, open{0}, requests{0}, games{0};
+    };
+
+    GameServer();
+    ~GameServer();
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Loads the word lists and binds the listeners; false with `error` set
+    // if anything fails.
+    bool start(const Options& opt, std::string& error);
+    // Serves until stop(); the calling thread is worker 0.
+    void run();
+    // Async-signal-safe; wakes every worker.
+    void stop();
+
+    const Counters& counters() const { return m_counters; }
+    int port() const { return m_port; } // bound TCP port
+
+private:
+    struct Session;
+    struct Worker;
+
+    void loop(Worker& w);
+    void acceptAll(Worker& w, int listenFd);
+    void readFrom(Worker& w, Session& s);
+    void handle(Session& s, const uint8_t* msg, size_t n);
+    void flushOut(Worker& w, Session& s);
+    void closeSession(Worker& w, Session& s);
+
+    Options m_opt;
+    GameState m_proto; // word lists shared by every session
+    int m_tcp = -1, m_unix = -1, m_stopFd = -1;
+    int m_port = -1;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    Counters m_counters;
+};
@@ -0,0 +1,295 @@
+#include "GameState.hpp"
+#include "WordList.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+GameState::GameState(uint64_t seed) : m_rng(seed) {}
+
+void GameState::setWordsPath(const std::string& path) {
+    m_wordsPath = path;
+    m_compiled = DictionaryFile{};
+    m_compiledChecked = false;
+    for (auto& l : m_byLength) l.reset();
+}
+
+void GameState::shareWords(const GameState& other) {
+    m_wordsPath = other.m_wordsPath;
+    m_compiled = other.m_compiled;
+    m_compiledChecked = other.m_compiledChecked;
+    for (int len=0; len<=WordCodes::kMaxLength; ++len) m_byLength[len] = other.m_byLength[len];
+}
+
+void GameState::loadDictionary() {
+    namespace fs = std::filesystem;
+    if (!m_compiledChecked) {
+        m_compiledChecked = true;
+        fs::path bin(m_wordsPath);
+        if (bin.extension() != ".bin") bin.replace_extension(".bin");
+        std::error_code e1, e2;
+        auto binTime = fs::last_write_time(bin, e1);
+        auto txtTime = fs::last_write_time(m_wordsPath, e2);
+        if (!e1 && (e2 || bin == fs::path(m_wordsPath) || binTime >= txtTime)) {
+            m_compiled.open(bin.string());
+        }
+    }
+
+    const int len = m_cfg.length;
+    if (!m_byLength[len]) {
+        auto l = std::make_shared<Loaded>();
+        l->dict = m_compiled.section(len);
+        if (l->dict.empty()) l->dict = Dictionary::load(m_wordsPath, len);
+        if (l->dict.empty()) l->dict = Dictionary::fromPacked(WordList::builtin(len), len);
+        l->index.build(l->dict);
+        l->columns.assign(l->dict);
+        l->suggest.build(l->dict);
+        l->book.load(HintBook::bookPath(m_wordsPath, len), l->dict);
+        m_byLength[len] = std::move(l);
+    }
+    m_dict = loaded().dict;
+    m_distance.resize(m_dict.size());
+    m_scored.resize(m_dict.size());
+}
+
+size_t GameState::pickSecret() {
+    if (m_cfg.daily) {
+        uint64_t s = dailySeed();
+        return s % m_dict.size();
+    }
+    std::uniform_int_distribution<size_t> d(0, m_dict.size()-1);
+    return d(m_rng);
+}
+
+void GameState::pickSecrets(size_t* out) {
+    out[0] = pickSecret();
+    // further boards: distinct words, from the date's sequence in daily mode
+    std::mt19937_64 daily(dailySeed());
+    std::uniform_int_distribution<size_t> d(0, m_dict.size()-1);
+    for (int b=1;b<m_cfg.boards;++b) {
+        do out[b] = m_cfg.daily ? d(daily) : d(m_rng);
+        while (std::find(out, out + b, out[b]) != out + b);
+    }
+}
+
+void GameState::setSecrets(const size_t* index) {
+    assignSecrets(index);
+    // setup clue + reveals
+    std::uniform_int_distribution<int> kd(1, 25);
+    m_caesarKey = kd(m_rng);
+    m_cipherClue = Rules::caesarShift(m_secret, m_caesarKey);
+    m_revealMask.assign(m_cfg.length, false);
+}
+
+void GameState::assignSecrets(const size_t* index) {
+    const int len = m_cfg.length;
+    for (int b=0;b<m_cfg.boards;++b) {
+        std::string_view w = m_dict[index[b]];
+        std::copy(w.begin(), w.end(), m_secrets.begin() + (size_t)b * len);
+        uint32_t mask = 0;
+        for (char c : w) mask |= 1u << (c - 'A');
+        m_secretLetters[b] = mask;
+    }
+    m_secretCols.assign(m_secrets.data(), m_cfg.boards, len);
+    m_secret.assign(m_secrets, 0, len);
+}
+
+void GameState::resetBoard() {
+    m_cfg.length = std::clamp(m_cfg.length, 4, WordCodes::kMaxLength); // builtin lists cover 4-6
+    // load dict for length (mapped or cached after the first time)
+    loadDictionary();
+    m_cfg.boards = std::clamp(m_cfg.boards, 1, std::min(kMaxBoards, (int)m_dict.size()));
+    if (m_cfg.adversarial) m_cfg.boards = 1;
+    m_cfg.attempts = std::clamp(m_cfg.attempts, 1, kMaxAttempts);
+    const int boards = m_cfg.boards;
+    m_rowCount = m_cfg.attempts + boards - 1;
+
+    // flat per-board arrays; resize keeps capacity across mode switches
+    m_secrets.resize((size_t)boards * m_cfg.length);
+    m_secretLetters.resize(boards);
+    m_patterns.resize(boards);
+    m_solvedAt.resize(boards);
+    m_cands.resize(boards);
+    m_rows.resize(m_rowCount);
+    m_states.resize((size_t)boards * m_rowCount * m_cfg.length);
+    m_keyState.resize((size_t)boards * 26);
+    restart();
+}
+
+void GameState::newGame(const GameConfig& cfg) {
+    m_cfg = cfg;
+    resetBoard();
+    size_t idx[kMaxBoards];
+    pickSecrets(idx);
+    setSecrets(idx);
+}
+
+void GameState::newGame(const GameConfig& cfg, size_t secretIndex) {
+    m_cfg = cfg;
+    resetBoard();
+    size_t idx[kMaxBoards];
+    for (int b=0;b<m_cfg.boards;++b) idx[b] = (secretIndex + b) % m_dict.size();
+    setSecrets(idx);
+}
+
+void GameState::restart() {
+    m_rowIndex = 0; m_current.clear();
+    std::fill(m_keyState.begin(), m_keyState.end(), 0);
+    m_win = false; m_outOfAttempts = false;
+    for (auto& r : m_rows) r.assign(m_cfg.length, ' ');
+    std::fill(m_states.begin(), m_states.end(), TileState::Absent);
+    std::fill(m_solvedAt.begin(), m_solvedAt.end(), -1);
+    m_solvedCount = 0;
+    for (auto& c : m_cands) c.reset(m_dict.size());
+    m_bookNode = m_cfg.adversarial ? HintBook::kOffBook : loaded().book.root();
+    // keep same secret & clue
+}
+
+bool GameState::typeLetter(char c) {
+    if (finished()) return false;
+    if (!std::isalpha((unsigned char)c)) return false;
+    if ((int)m_current.size() >= m_cfg.length) return false;
+    m_current.push_back((char)std::toupper((unsigned char)c));
+    return true;
+}
+
+bool GameState::backspace() {
+    if (m_current.empty()) return false;
+    m_current.pop_back();
+    return true;
+}
+
+SubmitResult GameState::submit() {
+    if (finished()) return SubmitResult::Finished;
+    if ((int)m_current.size() != m_cfg.length) return SubmitResult::TooShort;
+    if (!m_lenient && !loaded().index.contains(m_current)) {
+        return SubmitResult::NotInList;
+    }
+    const int len = m_cfg.length;
+    const int r = m_rowIndex;
+    if (m_cfg.adversarial) {
+        // no fixed secret: the feedback is whichever pattern leaves the most
+        // words, and any survivor stands in as the secret from here on
+        m_patterns[0] = m_cands[0].keepLargestBucket(m_current.data(), loaded().columns);
+        size_t rep = 0;
+        if (m_cands[0].sample(1, &rep)) assignSecrets(&rep);
+    } else {
+        // one batch scores the guess against every board's secret, and one
+        // against the dictionary narrows every board's candidates
+        BatchEval::evaluate(m_current.data(), m_secretCols, m_patterns.data());
+        BatchEval::evaluate(m_current.data(), loaded().columns, m_scored.data());
+    }
+    m_rows[r] = m_current;
+
+    for (int b=0;b<m_cfg.boards;++b) {
+        if (m_solvedAt[b] >= 0) continue; // solved boards take no more rows
+        const Pattern p = m_patterns[b];
+        TileState* st = stateRow(b, r);
+        Patterns::decode(p, len, st);
+        if (!m_cfg.adversarial) m_cands[b].keep(m_scored.data(), p);
+
+        int8_t* keys = m_keyState.data() + b * 26;
+        for (int i=0;i<len;++i) {
+            int idx = m_current[i]-'A';
+            int val = (st[i]==TileState::Correct?2:(st[i]==TileState::Present?1:0));
+            keys[idx] = (int8_t)std::max<int>(keys[idx], val);
+        }
+        // Mark letters that are completely wrong (not present in the word at all)
+        for (int i=0;i<len;++i) {
+            int idx = m_current[i]-'A';
+            if (st[i] == TileState::Absent && !((m_secretLetters[b] >> idx) & 1u)) {
+                keys[idx] = -1; // Use -1 to indicate wrong letter
+            }
+        }
+        if (p == Patterns::solved(len)) { m_solvedAt[b] = r; ++m_solvedCount; }
+    }
+    m_bookNode = loaded().book.next(m_bookNode, m_current, m_patterns[0]);
+
+    if (m_solvedCount == m_cfg.boards) {
+        m_win = true;
+        m_stats.record(true, m_rowIndex+1);
+    } else {
+        pushHintProgression();
+        m_rowIndex++;
+        if (m_rowIndex >= m_rowCount) {
+            m_outOfAttempts = true;
+            m_stats.record(false, m_rowCount);
+        }
+    }
+    m_current.clear();
+    return SubmitResult::Accepted;
+}
+
+size_t GameState::suggestions(size_t* out, size_t k) const {
+    if (!m_byLength[m_cfg.length]) return 0;
+    SuggestIndex::Query q;
+    // a solved board 0 scored no rows after the winning one
+    const int rows = m_solvedAt[0] >= 0 ? m_solvedAt[0] + 1 : m_rowIndex;
+    for (int r=0; r<rows; ++r) q.addFeedback(m_rows[r].data(), rowStates(r, 0), m_cfg.length);
+    q.setPrefix(m_current);
+    return loaded().suggest.query(q, out, k);
+}
+
+size_t GameState::nearest(std::string_view word, size_t* out, size_t k, int maxDistance) {
+    const int len = m_cfg.length;
+    if ((int)word.size() != len || k == 0 || !m_byLength[len]) return 0;
+    for (char c : word) if (c < 'A' || c > 'Z') return 0;
+    maxDistance = std::clamp(maxDistance, 0, len);
+    const size_t n = m_dict.size();
+    BatchEval::distances(word.data(), loaded().columns, m_distance.data());
+
+    // first k per distance in one pass; most words are further away
+    constexpr int kMaxK = 16;
+    size_t best[WordCodes::kMaxLength + 1][kMaxK];
+    size_t found[WordCodes::kMaxLength + 1] = {0};
+    k = std::min<size_t>(k, kMaxK);
+    const uint8_t* d = m_distance.data();
+    auto take = [&](size_t i) {
+        if (d[i] <= maxDistance && found[d[i]] < k) best[d[i]][found[d[i]]++] = i;
+    };
+    // skip eight words at a time unless one of their bytes is <= maxDistance
+    const uint64_t lo = 0x0101010101010101ull * (uint64_t)(maxDistance + 1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x;
+        std::memcpy(&x, d + i, 8);
+        if (((x - lo) & ~x & 0x8080808080808080ull) == 0) continue;
+        for (size_t j=0; j<8; ++j) take(i + j);
+    }
+    for (; i<n; ++i) take(i);
+    size_t got = 0;
+    for (int dist=0; dist<=maxDistance && got<k; ++dist)
+        for (size_t j=0; j<found[dist] && got<k; ++j) out[got++] = best[dist][j];
+    return got;
+}
+
+uint64_t GameState::stateHash() const {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&](const void* p, size_t n) {
+        const unsigned char* b = (const unsigned char*)p;
+        for (size_t i=0;i<n;++i) { h ^= b[i]; h *= 1099511628211ull; }
+    };
+    auto mixInt = [&](int64_t v) { mix(&v, sizeof(v)); };
+    mixInt(m_cfg.length); mixInt(m_cfg.boards); mixInt(m_rowCount);
+    mix(m_secrets.data(), m_secrets.size());
+    for (int r=0;r<m_rowIndex && r<m_rowCount;++r) mix(m_rows[r].data(), m_rows[r].size());
+    mix(m_current.data(), m_current.size());
+    mix(m_states.data(), m_states.size() * sizeof(TileState));
+    mix(m_keyState.data(), m_keyState.size());
+    mixInt(m_rowIndex); mixInt(m_win); mixInt(m_outOfAttempts); mixInt(m_caesarKey);
+    mixInt(m_stats.total); mixInt(m_stats.wins); mixInt(m_stats.currentStreak); mixInt(m_stats.maxStreak);
+    return h;
+}
+
+void GameState::pushHintProgression() {
+    if (m_cfg.adversarial) return; // nothing fixed to reveal
+    int used = m_rowIndex + 1;
+    if (used >= m_cfg.hintFrom) {
+        int idx[WordCodes::kMaxLength], n = 0;
+        for (int i=0;i<m_cfg.length;++i) if (!m_revealMask[i]) idx[n++] = i;
+        if (n > 0) {
+            std::uniform_int_distribution<int> d(0, n-1);
+            m_revealMask[idx[d(m_rng)]] = true;
+        }
+    }
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include "CandidateSet.hpp"
+#include "Dictionary.hpp"
+#include "HintBook.hpp"
+#include "Rules.hpp"
+#include "SuggestIndex.hpp"
+#include "WordIndex.hpp"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+
+struct Stats {
+    int total = 0, wins = 0;
+    int currentStreak = 0, maxStreak = 0;
+    int leadingStreak = 0; // wins before the first loss, for merge()
+    std::vector<int> distribution; // 1..N attempts
+    Stats() : distribution(10, 0) {}
+    void record(bool win, int attemptsUsed) {
+        total++;
+        if (win) {
+            if (wins == total - 1) leadingStreak++;
+            wins++; currentStreak++;
+            if (currentStreak > maxStreak) maxStreak = currentStreak;
+            if (attemptsUsed >= 1 && attemptsUsed <= (int)distribution.size())
+                distribution[attemptsUsed - 1]++;
+        } else {
+            currentStreak = 0;
+        }
+    }
+    // Append the games of `later` as if they were played after ours.
+    void merge(const Stats& later) {
+        bool allWon = wins == total, laterAllWon = later.wins == later.total;
+        maxStreak = std::max({maxStreak, later.maxStreak, currentStreak + later.leadingStreak});
+        if (allWon) leadingStreak += later.leadingStreak;
+        currentStreak = laterAllWon ? currentStreak + later.total : later.currentStreak;
+        total += later.total;
+        wins += later.wins;
+        if (distribution.size() < later.distribution.size()) distribution.resize(later.distribution.size(), 0);
+        for (size_t i=0;i<later.distribution.size();++i) distribution[i] += later.distribution[i];
+    }
+};
+
+struct GameConfig {
+    int length = 5;     // word length (4-6 recommended)
+    int attempts = 6;   // total rows
+    bool daily = false; // daily or random
+    int hintFrom = 4;   // guesses used before letters start being revealed
+    int boards = 1;     // secrets scored by every guess at once (1-64)
+    bool adversarial = false; // Absurdle: no fixed secret, each guess keeps the largest bucket
+};
+
+enum class SubmitResult { Accepted, TooShort, NotInList, Finished };
+
+// Headless game rules: dictionary, secret selection, scoring, hints and
+// stats. No SFML/ImGui here so it can be driven from tools and servers.
+class GameState {
+public:
+    static constexpr int kMaxBoards = 64;
+    static constexpr int kMaxAttempts = 20;
+
+    explicit GameState(uint64_t seed = std::random_device{}());
+
+    // lifecycle
+    void newGame(const GameConfig& cfg);
+    // Same, but with dictionary()[secretIndex] as the secret (simulations).
+    void newGame(const GameConfig& cfg, size_t secretIndex);
+    void restart();
+    // Text word list; a compiled `<name>.bin` next to it is preferred when
+    // it is at least as new.
+    void setWordsPath(const std::string& path);
+    // Use `other`'s word lists, indexes and hint books (read-only, shared)
+    // instead of loading them again; lets a server host many sessions.
+    void shareWords(const GameState& other);
+
+    // input
+    bool typeLetter(char c);
+    bool backspace();
+    SubmitResult submit();
+
+    void setLenient(bool lenient) { m_lenient = lenient; }
+    // Pin daily mode to a given Rules::dailySeed() value (replays); 0 = today.
+    void setDailySeed(uint64_t seed) { m_dailySeed = seed; }
+    uint64_t dailySeed() const { return m_dailySeed ? m_dailySeed : Rules::dailySeed(); }
+    // FNV-1a over secrets, rows, tile and key states, stats and status;
+    // equal hashes mean two sessions ended on the same board
+    uint64_t stateHash() const;
+    bool lenient() const { return m_lenient; }
+
+    // expose
+    const GameConfig& config() const { return m_cfg; }
+    const Stats& stats() const { return m_stats; }
+    const Dictionary& dictionary() const { return m_dict; }
+    // dictionary words still consistent with every row submitted to a board
+    const CandidateSet& candidates(int board = 0) const { return m_cands[board]; }
+    // board 0's secret; hints and the cipher clue are about this one
+    const std::string& secret() const { return m_secret; }
+    std::string_view secret(int board) const {
+        return std::string_view(m_secrets).substr((size_t)board * m_cfg.length, m_cfg.length);
+    }
+    const std::string& current() const { return m_current; }
+    const std::string& row(int r) const { return m_rows[r]; }
+    // m_cfg.length tiles; rows after a board was solved stay Absent
+    const TileState* rowStates(int r, int board = 0) const {
+        return m_states.data() + ((size_t)board * m_rowCount + r) * m_cfg.length;
+    }
+    int rowIndex() const { return m_rowIndex; }
+    int keyState(int letter, int board = 0) const { return m_keyState[board * 26 + letter]; }
+    int boards() const { return m_cfg.boards; }
+    int rows() const { return m_rowCount; } // attempts + boards - 1
+    // row that solved the board, or -1
+    int solvedAt(int board) const { return m_solvedAt[board]; }
+    int solvedCount() const { return m_solvedCount; }
+    int caesarKey() const { return m_caesarKey; }
+    const std::string& cipherClue() const { return m_cipherClue; }
+    // next guess from the precomputed hint book for board 0 (cipher-book);
+    // empty without a book for this dictionary or once a guess left it
+    std::string_view bookHint() const {
+        return m_bookNode == HintBook::kOffBook ? std::string_view() : loaded().book.guess(m_bookNode);
+    }
+    bool hasBook() const { return m_byLength[m_cfg.length] && !loaded().book.empty(); }
+    // Dictionary words that fit everything board 0 has shown and start with
+    // the letters typed so far: the first `k` in dictionary order go to
+    // `out`, the return value counts all of them.
+    size_t suggestions(size_t* out, size_t k) const;
+    // Dictionary words at most `maxDistance` letters away from `word` (same
+    // length, Hamming distance), closest first then in dictionary order: up
+    // to `k` go to `out`, returns how many. For "did you mean" after
+    // NotInList; scans the whole dictionary with the SIMD distance kernel.
+    size_t nearest(std::string_view word, size_t* out, size_t k, int maxDistance = 2);
+    bool revealed(int i) const { return m_revealMask[i]; }
+    bool won() const { return m_win; }
+    bool outOfAttempts() const { return m_outOfAttempts; }
+    bool finished() const { return m_win || m_outOfAttempts; }
+
+private:
+    void loadDictionary();
+    void resetBoard();
+    size_t pickSecret();
+    void pickSecrets(size_t* out);
+    void setSecrets(const size_t* index);   // plus a new clue
+    void assignSecrets(const size_t* index);
+    TileState* stateRow(int board, int r) {
+        return m_states.data() + ((size_t)board * m_rowCount + r) * m_cfg.length;
+    }
+    void pushHintProgression();
+
+private:
+    GameConfig m_cfg{};
+    std::string m_wordsPath = "assets/words.txt";
+    bool m_lenient = true; // allow guesses not in dictionary
+    uint64_t m_dailySeed = 0;
+    Dictionary m_dict; // candidates, sorted
+    DictionaryFile m_compiled;
+    // per length: dictionary, membership index and column-major letters for
+    // batch scoring; built once, reused on mode switches and never modified
+    // afterwards, so GameStates can share them
+    struct Loaded { Dictionary dict; WordIndex index; LetterColumns columns; HintBook book; SuggestIndex suggest; };
+    std::shared_ptr<const Loaded> m_byLength[WordCodes::kMaxLength + 1];
+    const Loaded& loaded() const { return *m_byLength[m_cfg.length]; }
+    bool m_compiledChecked = false;
+    std::string m_secret;
+
+    // per-board state, flat and board-major so one guess touches each
+    // board's slice in a single pass
+    std::string m_secrets;               // boards * length letters
+    LetterColumns m_secretCols;          // secrets column-wise, scored in one batch
+    std::vector<uint32_t> m_secretLetters; // letter bitmask per board
+    std::vector<Pattern> m_patterns;     // last guess's pattern per board
+    std::vector<int> m_solvedAt;         // per board, -1 while open
+    std::vector<CandidateSet> m_cands;   // per board
+    int m_solvedCount = 0;
+
+    // guesses
+    std::vector<std::string> m_rows;
+    std::vector<TileState> m_states;     // [board][row][tile]
+    int m_rowCount = 0;
+    int m_rowIndex = 0;
+    std::string m_current;
+
+    // hints
+    int m_caesarKey = 0;
+    std::string m_cipherClue;
+    std::vector<bool> m_revealMask;
+    uint32_t m_bookNode = HintBook::kOffBook; // position in loaded().book
+
+    // rng
+    std::mt19937_64 m_rng;
+
+    // keyboard heatmap targets, [board][letter]
+    std::vector<int8_t> m_keyState; // -1 wrong, 0 unused, 1 present, 2 correct
+    std::vector<uint8_t> m_distance; // nearest() scratch, one byte per dictionary word
+    std::vector<Pattern> m_scored;   // submit(): the guess scored against every word, shared by all boards
+
+    // session stats
+    Stats m_stats;
+
+    // status
+    bool m_win = false;
+    bool m_outOfAttempts = false;
+};
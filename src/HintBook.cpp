@@ -0,0 +1,279 @@
+#include "HintBook.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace {
+    const char kMagic[8] = {'C','P','H','R','B','O','O','K'};
+
+    // buckets at least this big build their children as parallel tasks;
+    // smaller ones are cheaper to finish on the current thread
+    constexpr size_t kParallelMin = 64;
+
+    // One finished subtree, root first, child indices relative to it.
+    struct Subtree {
+        std::vector<HintBook::Node> nodes;
+        std::vector<HintBook::Edge> edges;
+    };
+
+    class Builder {
+    public:
+        // `prevNodes`/`prevEdges`: an earlier book for the same length, or empty
+        Builder(const Dictionary& words, const Solver& solver, ThreadPool& pool, const Solver::Options& opt,
+                const std::vector<HintBook::Node>& prevNodes, const std::vector<HintBook::Edge>& prevEdges)
+            : m_words(words), m_solver(solver), m_pool(pool), m_opt(opt), m_len(words.length()),
+              m_prevNodes(prevNodes), m_prevEdges(prevEdges) {
+            for (uint32_t i=0; i<(uint32_t)prevNodes.size(); ++i) m_prev.emplace(prevNodes[i].setHash, i);
+        }
+
+        void node(const std::vector<int>& cands, Subtree& out) {
+            const uint64_t hash = setHash(cands);
+            auto it = m_prev.find(hash);
+            if (it != m_prev.end() && m_prevNodes[it->second].candidates == cands.size()) {
+                size_t mark = out.nodes.size(), edgeMark = out.edges.size();
+                if (copy(it->second, out)) { m_reused += out.nodes.size() - mark; return; }
+                out.nodes.resize(mark); out.edges.resize(edgeMark);
+            }
+
+            int guess = m_solver.best(cands, m_opt).guess;
+            std::vector<std::pair<Pattern, std::vector<int>>> buckets;
+            partition(guess, cands, buckets);
+            if (buckets.size() == 1 && buckets[0].first != Patterns::solved(m_len)) {
+                // no information: guess a candidate so the tree always progresses
+                guess = cands[0];
+                partition(guess, cands, buckets);
+            }
+            if (!buckets.empty() && buckets.back().first == Patterns::solved(m_len)) buckets.pop_back();
+
+            std::vector<Subtree> kids(buckets.size());
+            auto buildKids = [&](size_t b, size_t e) {
+                for (size_t k=b; k<e; ++k) node(buckets[k].second, kids[k]);
+            };
+            if (cands.size() >= kParallelMin && kids.size() > 1) m_pool.parallelFor(kids.size(), 1, buildKids);
+            else buildKids(0, kids.size());
+
+            HintBook::Node n{};
+            n.setHash = hash;
+            n.candidates = (uint32_t)cands.size();
+            n.firstEdge = 0;
+            n.edges = (uint16_t)kids.size();
+            std::memcpy(n.guess, m_words[guess].data(), m_len);
+            out.nodes.push_back(n);
+            out.edges.resize(kids.size());
+            for (size_t k=0; k<kids.size(); ++k) {
+                const uint32_t nodeBase = (uint32_t)out.nodes.size(), edgeBase = (uint32_t)out.edges.size();
+                out.edges[k] = {nodeBase, buckets[k].first, 0};
+                for (HintBook::Node c : kids[k].nodes) { c.firstEdge += edgeBase; out.nodes.push_back(c); }
+                for (HintBook::Edge e : kids[k].edges) { e.child += nodeBase; out.edges.push_back(e); }
+            }
+        }
+
+        size_t reused() const { return m_reused.load(); }
+
+    private:
+        uint64_t setHash(const std::vector<int>& cands) const {
+            uint64_t h = 1469598103934665603ull;
+            for (int a : cands) {
+                for (unsigned char c : m_words[a]) { h ^= c; h *= 1099511628211ull; }
+                h ^= '\n'; h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        void partition(int guess, const std::vector<int>& cands,
+                       std::vector<std::pair<Pattern, std::vector<int>>>& out) const {
+            out.clear();
+            std::vector<int> slot(Patterns::count(m_len), -1);
+            const char* g = m_words[guess].data();
+            for (int a : cands) {
+                Pattern p = Patterns::score(m_words[a].data(), g, m_len);
+                if (slot[p] < 0) { slot[p] = (int)out.size(); out.push_back({p, {}}); }
+                out[slot[p]].second.push_back(a);
+            }
+            std::sort(out.begin(), out.end(), [](const auto& x, const auto& y){ return x.first < y.first; });
+        }
+
+        // Appends the previous book's subtree at `from`; fails if one of its
+        // guesses is no longer a word.
+        bool copy(uint32_t from, Subtree& out) const {
+            const HintBook::Node& src = m_prevNodes[from];
+            if (!m_words.contains(std::string_view(src.guess, m_len))) return false;
+            const size_t firstEdge = out.edges.size();
+            HintBook::Node n = src;
+            n.firstEdge = (uint32_t)firstEdge;
+            out.nodes.push_back(n);
+            out.edges.resize(firstEdge + src.edges);
+            for (uint16_t k=0; k<src.edges; ++k) {
+                const HintBook::Edge& e = m_prevEdges[src.firstEdge + k];
+                out.edges[firstEdge + k] = {(uint32_t)out.nodes.size(), e.pattern, 0};
+                if (!copy(e.child, out)) return false;
+            }
+            return true;
+        }
+
+        const Dictionary& m_words;
+        const Solver& m_solver;
+        ThreadPool& m_pool;
+        Solver::Options m_opt;
+        int m_len;
+        const std::vector<HintBook::Node>& m_prevNodes;
+        const std::vector<HintBook::Edge>& m_prevEdges;
+        std::unordered_map<uint64_t, uint32_t> m_prev; // set hash -> node
+        std::atomic<size_t> m_reused{0};
+    };
+}
+
+std::string HintBook::bookPath(const std::string& wordsPath, int len) {
+    std::filesystem::path p(wordsPath);
+    p.replace_extension(std::to_string(len) + ".book");
+    return p.string();
+}
+
+HintBook::BuildStats HintBook::build(const Dictionary& words, const Solver& solver, ThreadPool& pool,
+                                     const Solver::Options& opt, const HintBook* previous) {
+    // the previous book may be mapped from the file about to be replaced
+    std::vector<Node> prevNodes;
+    std::vector<Edge> prevEdges;
+    if (previous && !previous->empty() && previous->length() == words.length()) {
+        prevNodes.assign(previous->m_nodes, previous->m_nodes + previous->m_nodeCount);
+        prevEdges.assign(previous->m_edges, previous->m_edges + previous->m_edgeCount);
+    }
+
+    Subtree tree;
+    BuildStats st;
+    if (!words.empty()) {
+        Builder b(words, solver, pool, opt, prevNodes, prevEdges);
+        std::vector<int> all(words.size());
+        for (size_t i=0; i<all.size(); ++i) all[i] = (int)i;
+        b.node(all, tree);
+        st.reused = b.reused();
+    }
+
+    m_file.close();
+    m_len = words.length();
+    m_words = words.size();
+    m_hash = PatternMatrix::hashWords(words);
+    m_ownedNodes = std::move(tree.nodes);
+    m_ownedEdges = std::move(tree.edges);
+    m_nodes = m_ownedNodes.data();
+    m_edges = m_ownedEdges.data();
+    m_nodeCount = m_ownedNodes.size();
+    m_edgeCount = m_ownedEdges.size();
+    st.nodes = m_nodeCount;
+    return st;
+}
+
+bool HintBook::save(const std::string& path) const {
+    if (empty()) return false;
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.length = (uint32_t)m_len;
+    h.words = m_words;
+    h.dictHash = m_hash;
+    h.nodes = m_nodeCount;
+    h.edges = m_edgeCount;
+
+    // write beside the target and rename so readers never map a partial file
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)m_nodes, (std::streamsize)(m_nodeCount * sizeof(Node)));
+        out.write((const char*)m_edges, (std::streamsize)(m_edgeCount * sizeof(Edge)));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { std::filesystem::remove(tmp, ec); return false; }
+    return true;
+}
+
+bool HintBook::open(const std::string& path) {
+    MappedFile f;
+    if (!f.open(path) || f.size() < sizeof(Header)) return false;
+    Header h;
+    std::memcpy(&h, f.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion) return false;
+    if (h.length < 1 || h.length > (uint32_t)Patterns::kMaxLength || h.nodes == 0) return false;
+    // overflow-safe form of size == Header + nodes * Node + edges * Edge
+    const size_t body = f.size() - sizeof(Header);
+    if (h.nodes > body / sizeof(Node) || h.nodes >= kOffBook) return false;
+    if (body - h.nodes * sizeof(Node) != h.edges * sizeof(Edge) || h.edges > body / sizeof(Edge)) return false;
+
+    // every index next() and cost() follow must stay inside the arrays:
+    // edge ranges in bounds and sorted by pattern, children later in preorder
+    const Node* nodes = (const Node*)(f.data() + sizeof(Header));
+    const Edge* edges = (const Edge*)(f.data() + sizeof(Header) + h.nodes * sizeof(Node));
+    const size_t patterns = Patterns::count((int)h.length);
+    for (uint64_t i=0; i<h.nodes; ++i) {
+        const Node& n = nodes[i];
+        if ((uint64_t)n.firstEdge + n.edges > h.edges) return false;
+        for (uint32_t k=0; k<h.length; ++k)
+            if (n.guess[k] < 'A' || n.guess[k] > 'Z') return false;
+        for (uint16_t k=0; k<n.edges; ++k) {
+            const Edge& e = edges[n.firstEdge + k];
+            if (e.child <= i || e.child >= h.nodes || e.pattern >= patterns) return false;
+            if (k && edges[n.firstEdge + k - 1].pattern >= e.pattern) return false;
+        }
+    }
+
+    m_ownedNodes.clear(); m_ownedNodes.shrink_to_fit();
+    m_ownedEdges.clear(); m_ownedEdges.shrink_to_fit();
+    m_len = (int)h.length;
+    m_words = (size_t)h.words;
+    m_hash = h.dictHash;
+    m_nodeCount = (size_t)h.nodes;
+    m_edgeCount = (size_t)h.edges;
+    m_file = std::move(f);
+    m_nodes = (const Node*)(m_file.data() + sizeof(Header));
+    m_edges = (const Edge*)(m_file.data() + sizeof(Header) + m_nodeCount * sizeof(Node));
+    return true;
+}
+
+bool HintBook::matches(const Dictionary& words) const {
+    return !empty() && m_len == words.length() && m_words == words.size() &&
+           m_hash == PatternMatrix::hashWords(words);
+}
+
+bool HintBook::load(const std::string& path, const Dictionary& words) {
+    HintBook b;
+    if (!b.open(path) || !b.matches(words)) return false;
+    *this = std::move(b);
+    return true;
+}
+
+uint32_t HintBook::next(uint32_t node, std::string_view played, Pattern p) const {
+    if (node == kOffBook || guess(node) != played) return kOffBook;
+    const Node& n = m_nodes[node];
+    const Edge* first = m_edges + n.firstEdge;
+    const Edge* last = first + n.edges;
+    const Edge* e = std::lower_bound(first, last, p, [](const Edge& x, Pattern v) { return x.pattern < v; });
+    return e != last && e->pattern == p ? e->child : kOffBook;
+}
+
+void HintBook::cost(uint64_t& totalGuesses, int& maxGuesses) const {
+    totalGuesses = 0; maxGuesses = 0;
+    if (empty()) return;
+    // preorder: walk with an explicit stack of (node, depth)
+    std::vector<std::pair<uint32_t, int>> stack{{0u, 1}};
+    while (!stack.empty()) {
+        auto [id, depth] = stack.back();
+        stack.pop_back();
+        const Node& n = m_nodes[id];
+        uint32_t below = 0;
+        for (uint16_t k=0; k<n.edges; ++k) {
+            uint32_t child = m_edges[n.firstEdge + k].child;
+            below += m_nodes[child].candidates;
+            stack.push_back({child, depth + 1});
+        }
+        if (below < n.candidates) { // the guess itself was one of the candidates
+            totalGuesses += depth;
+            maxGuesses = std::max(maxGuesses, depth);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Dictionary.hpp"
+#include "MappedFile.hpp"
+#include "Pattern.hpp"
+#include "Solver.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Precomputed strategy tree over one dictionary: the guess to play at every
+// node, with children indexed by the feedback pattern. Built offline by
+// cipher-book and mapped at runtime, so a hint costs one edge lookup per
+// guess played. Nodes carry their guess as letters and a hash of their
+// candidate set, which lets a rebuild for an edited word list copy every
+// subtree whose candidates did not change.
+//
+// File layout (little endian): Header | Node x nodes | Edge x edges. Nodes
+// are in preorder; each node's edges are contiguous and sorted by pattern.
+class HintBook {
+public:
+    static constexpr uint32_t kOffBook = 0xFFFFFFFFu;
+
+    struct Node {
+        uint64_t setHash;    // FNV-1a over the candidate words, in order
+        uint32_t candidates;
+        uint32_t firstEdge;
+        uint16_t edges;
+        char     guess[Patterns::kMaxLength];
+    };
+    struct Edge {
+        uint32_t child;
+        Pattern  pattern;
+        uint16_t reserved;
+    };
+    struct BuildStats {
+        size_t nodes = 0;
+        size_t reused = 0;   // nodes copied from the previous book
+    };
+
+    HintBook() = default;
+
+    // Full tree over every word in `words`. Guesses come from `solver`;
+    // subtrees whose candidate set also appears in `previous` are copied.
+    BuildStats build(const Dictionary& words, const Solver& solver, ThreadPool& pool,
+                     const Solver::Options& opt, const HintBook* previous = nullptr);
+
+    bool save(const std::string& path) const;
+    // Maps any well-formed book; matches() says whether it fits a dictionary.
+    bool open(const std::string& path);
+    // Maps `path` only if it was built for exactly `words`.
+    bool load(const std::string& path, const Dictionary& words);
+    bool matches(const Dictionary& words) const;
+
+    static std::string bookPath(const std::string& wordsPath, int len);
+
+    bool empty() const { return m_nodeCount == 0; }
+    size_t nodes() const { return m_nodeCount; }
+    int length() const { return m_len; }
+    bool mapped() const { return m_file.isOpen(); }
+
+    // lookup
+    uint32_t root() const { return empty() ? kOffBook : 0; }
+    std::string_view guess(uint32_t node) const { return {m_nodes[node].guess, (size_t)m_len}; }
+    // Node reached by playing `played` at `node` and seeing `p`; kOffBook if
+    // `played` was not the book's guess or it solved the word.
+    uint32_t next(uint32_t node, std::string_view played, Pattern p) const;
+
+    // Sum of guesses to solve every word, and the worst case.
+    void cost(uint64_t& totalGuesses, int& maxGuesses) const;
+
+private:
+    struct Header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t length;
+        uint64_t words;
+        uint64_t dictHash;
+        uint64_t nodes;
+        uint64_t edges;
+    };
+    static constexpr uint32_t kVersion = 1;
+
+    int m_len = 0;
+    size_t m_words = 0;
+    uint64_t m_hash = 0;
+    const Node* m_nodes = nullptr;
+    const Edge* m_edges = nullptr;
+    size_t m_nodeCount = 0, m_edgeCount = 0;
+    std::vector<Node> m_ownedNodes;
+    std::vector<Edge> m_ownedEdges;
+    MappedFile m_file;
+};
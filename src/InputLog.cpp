@@ -0,0 +1,134 @@
+#include "InputLog.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+
+namespace {
+    constexpr char kMagic[8] = {'C','P','H','R','L','O','G','\0'};
+    constexpr uint32_t kVersion = 1;
+    constexpr size_t kHeaderBytes = sizeof(kMagic) + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    constexpr size_t kConfigBytes = 4 * sizeof(int32_t) + 1;
+
+    // payload bytes after the op byte; 0 for unknown ops
+    size_t payloadBytes(uint8_t op) {
+        switch ((InputLog::Op)op) {
+        case InputLog::Op::Frame: return sizeof(float);
+        case InputLog::Op::Text: return sizeof(uint32_t);
+        case InputLog::Op::Key: return sizeof(int32_t);
+        case InputLog::Op::NewGame: return kConfigBytes;
+        case InputLog::Op::Restart: return 0;
+        case InputLog::Op::Lenient: return 1;
+        case InputLog::Op::End: return sizeof(uint64_t);
+        }
+        return 0;
+    }
+
+    bool knownOp(uint8_t op) {
+        return op == 'F' || op == 'T' || op == 'K' || op == 'N' || op == 'R' || op == 'L' || op == 'E';
+    }
+}
+
+bool InputLog::create(const std::string& path, uint64_t seed, uint64_t dailySeed) {
+    close();
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_out) return false;
+    put(kMagic, sizeof(kMagic));
+    put(&kVersion, sizeof(kVersion));
+    put(&seed, sizeof(seed));
+    put(&dailySeed, sizeof(dailySeed));
+    return (bool)m_out;
+}
+
+void InputLog::frame(float dt) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::Frame;
+    put(&op, 1); put(&dt, sizeof(dt));
+}
+
+void InputLog::text(uint32_t unicode) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::Text;
+    put(&op, 1); put(&unicode, sizeof(unicode));
+}
+
+void InputLog::key(int code) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::Key;
+    int32_t v = code;
+    put(&op, 1); put(&v, sizeof(v));
+}
+
+void InputLog::newGame(const GameConfig& cfg) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::NewGame;
+    int32_t v[4] = {cfg.length, cfg.attempts, cfg.hintFrom, cfg.boards};
+    uint8_t flags = (cfg.daily ? 1 : 0) | (cfg.adversarial ? 2 : 0);
+    put(&op, 1); put(v, sizeof(v)); put(&flags, 1);
+}
+
+void InputLog::restart() {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::Restart;
+    put(&op, 1);
+}
+
+void InputLog::lenient(bool on) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::Lenient, v = on ? 1 : 0;
+    put(&op, 1); put(&v, 1);
+}
+
+void InputLog::finish(uint64_t stateHash) {
+    if (!recording()) return;
+    uint8_t op = (uint8_t)Op::End;
+    put(&op, 1); put(&stateHash, sizeof(stateHash));
+    close();
+}
+
+void InputLog::close() {
+    if (m_out.is_open()) m_out.close();
+}
+
+InputLog::Contents InputLog::read(const std::string& path) {
+    Contents c;
+    MappedFile f;
+    if (!f.open(path)) { c.error = "cannot open " + path; return c; }
+    const uint8_t* p = f.data();
+    const uint8_t* end = p + f.size();
+    uint32_t version = 0;
+    if (f.size() < kHeaderBytes || std::memcmp(p, kMagic, sizeof(kMagic)) != 0) {
+        c.error = path + " is not an input log";
+        return c;
+    }
+    std::memcpy(&version, p + sizeof(kMagic), sizeof(version));
+    if (version != kVersion) { c.error = "unsupported input log version"; return c; }
+    std::memcpy(&c.seed, p + sizeof(kMagic) + sizeof(version), sizeof(c.seed));
+    std::memcpy(&c.dailySeed, p + sizeof(kMagic) + sizeof(version) + sizeof(c.seed), sizeof(c.dailySeed));
+    p += kHeaderBytes;
+
+    while (p < end && !c.finished) {
+        uint8_t op = *p++;
+        size_t n = payloadBytes(op);
+        if (!knownOp(op) || (size_t)(end - p) < n) { c.error = "corrupt record"; break; }
+        Record r;
+        r.op = (Op)op;
+        switch (r.op) {
+        case Op::Frame: std::memcpy(&r.dt, p, n); ++c.frames; break;
+        case Op::Text:
+        case Op::Key: std::memcpy(&r.value, p, n); break;
+        case Op::NewGame: {
+            int32_t v[4];
+            std::memcpy(v, p, sizeof(v));
+            r.cfg.length = v[0]; r.cfg.attempts = v[1]; r.cfg.hintFrom = v[2]; r.cfg.boards = v[3];
+            r.cfg.daily = (p[sizeof(v)] & 1) != 0;
+            r.cfg.adversarial = (p[sizeof(v)] & 2) != 0;
+            break;
+        }
+        case Op::Restart: break;
+        case Op::Lenient: r.value = *p; break;
+        case Op::End: std::memcpy(&r.hash, p, n); c.finished = true; break;
+        }
+        p += n;
+        c.records.push_back(r);
+    }
+    return c;
+}
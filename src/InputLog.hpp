@@ -0,0 +1,68 @@
+#pragma once
+#include "GameState.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Compact binary log of everything that drives a Game: the RNG seed, then
+// one record per text/key event, menu action and frame dt, in the order
+// they happened. Feeding the records back through the same Game calls
+// reproduces the session exactly; the closing record carries a hash of
+// the final GameState to check that against.
+//
+// Layout: 8-byte magic, u32 version, u64 seed, u64 daily seed, then
+// records of a one-byte op followed by its fixed-size payload (little
+// endian).
+class InputLog {
+public:
+    enum class Op : uint8_t {
+        Frame = 'F',   // f32 dt, after the frame's events
+        Text = 'T',    // u32 unicode
+        Key = 'K',     // i32 sf::Keyboard::Key
+        NewGame = 'N', // GameConfig: i32 length, attempts, hintFrom, boards; u8 daily|adversarial<<1
+        Restart = 'R',
+        Lenient = 'L', // u8
+        End = 'E',     // u64 final state hash
+    };
+
+    struct Record {
+        Op op = Op::Frame;
+        float dt = 0.f;
+        int32_t value = 0;      // unicode, key code or lenient flag
+        GameConfig cfg{};
+        uint64_t hash = 0;
+    };
+
+    struct Contents {
+        uint64_t seed = 0;
+        uint64_t dailySeed = 0; // the recording day's Rules::dailySeed()
+        std::vector<Record> records;
+        size_t frames = 0;
+        bool finished = false;  // ends with an End record
+        std::string error;      // non-empty if the file could not be read
+    };
+
+    InputLog() = default;
+    ~InputLog() { close(); }
+    InputLog(const InputLog&) = delete;
+    InputLog& operator=(const InputLog&) = delete;
+
+    // writing
+    bool create(const std::string& path, uint64_t seed, uint64_t dailySeed);
+    bool recording() const { return m_out.is_open(); }
+    void frame(float dt);
+    void text(uint32_t unicode);
+    void key(int code);
+    void newGame(const GameConfig& cfg);
+    void restart();
+    void lenient(bool on);
+    void finish(uint64_t stateHash); // writes End and closes
+    void close();
+
+    static Contents read(const std::string& path);
+
+private:
+    void put(const void* p, size_t n) { m_out.write((const char*)p, (std::streamsize)n); }
+    std::ofstream m_out;
+};
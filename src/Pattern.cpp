@@ -0,0 +1,47 @@
+#include "Pattern.hpp"
+
+Pattern Patterns::encode(const TileState* states, int len) {
+    int p = 0;
+    for (int i=len-1;i>=0;--i) p = p*3 + (int)states[i];
+    return (Pattern)p;
+}
+
+void Patterns::decode(Pattern p, int len, TileState* out) {
+    for (int i=0;i<len;++i) {
+        out[i] = (TileState)(p % 3);
+        p /= 3;
+    }
+}
+
+Pattern Patterns::score(const char* secret, const char* guess, int len) {
+    switch (len) {
+    case 4: return score<4>(secret, guess);
+    case 5: return score<5>(secret, guess);
+    case 6: return score<6>(secret, guess);
+    default: break;
+    }
+    static constexpr int pow3[kMaxLength] = {1, 3, 9, 27, 81, 243};
+    int counts[26] = {0};
+    int p = 0;
+    unsigned green = 0;
+
+    // correct; unmatched secret letters stay available for yellows
+    for (int i=0;i<len;++i) {
+        if (guess[i] == secret[i]) {
+            p += 2*pow3[i];
+            green |= 1u << i;
+        } else {
+            counts[secret[i]-'A']++;
+        }
+    }
+    // present
+    for (int i=0;i<len;++i) {
+        if (green & (1u << i)) continue;
+        int idx = guess[i]-'A';
+        if (idx>=0 && idx<26 && counts[idx] > 0) {
+            p += pow3[i];
+            counts[idx]--;
+        }
+    }
+    return (Pattern)p;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Rules.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Feedback for one guess packed as a base-3 number: tile i contributes
+// state * 3^i (Absent 0, Present 1, Correct 2). 3^5 = 243 fits a byte,
+// 3^6 = 729 needs 16 bits.
+using Pattern = uint16_t;
+
+namespace Patterns {
+    constexpr int kMaxLength = 6;
+
+    constexpr int count(int len) {
+        int n = 1;
+        for (int i=0;i<len;++i) n *= 3;
+        return n;
+    }
+    // all tiles correct
+    constexpr Pattern solved(int len) { return (Pattern)(count(len) - 1); }
+    // bytes per matrix cell for a given length
+    constexpr int cellBytes(int len) { return count(len) <= 256 ? 1 : 2; }
+
+    Pattern encode(const TileState* states, int len);
+    void decode(Pattern p, int len, TileState* out);
+
+    // Same rules as Rules::evaluate(), without touching the heap. Lengths
+    // 4-6 dispatch to score<N>; others take the generic loop.
+    Pattern score(const char* secret, const char* guess, int len);
+
+    namespace detail {
+        // f(0), f(1), ... f(N-1) as straight-line code; the index arrives
+        // as a std::integral_constant so it stays a compile-time constant
+        template <int N, class F>
+        inline void unrolled(F&& f) {
+            [&]<int... I>(std::integer_sequence<int, I...>) {
+                (f(std::integral_constant<int, I>{}), ...);
+            }(std::make_integer_sequence<int, N>{});
+        }
+    }
+
+    // Fixed length, fully unrolled and branch-free: each guess letter that is
+    // not green takes the first still-unused non-green secret position
+    // holding the same letter, so yellows are limited by the letter counts.
+    template <int N>
+    inline Pattern score(const char* secret, const char* guess) {
+        static_assert(N >= 1 && N <= kMaxLength, "pattern length out of range");
+        unsigned green = 0;
+        detail::unrolled<N>([&](auto i) { green |= (unsigned)(guess[i] == secret[i]) << i; });
+        unsigned avail = ~green & ((1u << N) - 1);
+        int p = 0;
+        detail::unrolled<N>([&](auto i) {
+            unsigned same = 0;
+            detail::unrolled<N>([&](auto j) { same |= (unsigned)(guess[i] == secret[j]) << j; });
+            const unsigned g = (green >> i) & 1u;
+            unsigned m = same & avail & (g - 1u);   // no match for a green tile
+            avail &= ~(m & (0u - m));               // use the lowest match
+            p += count(i()) * (int)(2 * g + (m != 0));
+        });
+        return (Pattern)p;
+    }
+}
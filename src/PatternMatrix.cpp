@@ -0,0 +1,119 @@
+#include "PatternMatrix.hpp"
+#include "BatchEval.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace {
+    const char kMagic[8] = {'C','P','H','R','P','A','T','\0'};
+}
+
+uint64_t PatternMatrix::hashWords(const Dictionary& words) {
+    // FNV-1a over the words in order, newline separated
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i=0; i<words.size(); ++i) {
+        for (unsigned char c : words[i]) { h ^= c; h *= 1099511628211ull; }
+        h ^= '\n'; h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string PatternMatrix::cachePath(const std::string& wordsPath, int len) {
+    std::filesystem::path p(wordsPath);
+    p.replace_extension(std::to_string(len) + ".pat");
+    return p.string();
+}
+
+void PatternMatrix::build(const Dictionary& words, int threads) {
+    m_file.close();
+    m_count = words.size();
+    m_len = words.length();
+    m_cellBytes = Patterns::cellBytes(m_len);
+    m_hash = hashWords(words);
+    m_owned.assign(m_count * m_count * m_cellBytes, 0);
+    m_cells = m_owned.data();
+    if (m_count == 0) return;
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<size_t>(threads, m_count);
+
+    LetterColumns cols(words);
+    auto work = [&](size_t begin, size_t end) {
+        for (size_t g=begin; g<end; ++g) {
+            const char* guess = words[g].data();
+            if (m_cellBytes == 1) BatchEval::evaluate(guess, cols, m_owned.data() + g * m_count);
+            else BatchEval::evaluate(guess, cols, (uint16_t*)m_owned.data() + g * m_count);
+        }
+    };
+    std::vector<std::thread> pool;
+    size_t chunk = (m_count + threads - 1) / threads;
+    for (int t=0; t<threads; ++t) {
+        size_t b = t * chunk, e = std::min(m_count, b + chunk);
+        if (b < e) pool.emplace_back(work, b, e);
+    }
+    for (auto& th : pool) th.join();
+}
+
+bool PatternMatrix::save(const std::string& path) const {
+    if (empty()) return false;
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.length = (uint32_t)m_len;
+    h.count = m_count;
+    h.dictHash = m_hash;
+    h.cellBytes = (uint32_t)m_cellBytes;
+
+    // write beside the target and rename so readers never map a partial file
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)m_cells, (std::streamsize)(m_count * m_count * m_cellBytes));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { std::filesystem::remove(tmp, ec); return false; }
+    return true;
+}
+
+bool PatternMatrix::load(const std::string& path, const Dictionary& words) {
+    MappedFile f;
+    if (!f.open(path) || f.size() < sizeof(Header)) return false;
+    Header h;
+    std::memcpy(&h, f.data(), sizeof(h));
+    int len = words.length();
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kVersion) return false;
+    if ((int)h.length != len || h.count != words.size()) return false;
+    if ((int)h.cellBytes != Patterns::cellBytes(len)) return false;
+    if (h.dictHash != hashWords(words)) return false;
+    if (f.size() != sizeof(Header) + h.count * h.count * h.cellBytes) return false;
+
+    m_owned.clear(); m_owned.shrink_to_fit();
+    m_len = len;
+    m_cellBytes = (int)h.cellBytes;
+    m_count = (size_t)h.count;
+    m_hash = h.dictHash;
+    m_file = std::move(f);
+    m_cells = m_file.data() + sizeof(Header);
+    return true;
+}
+
+PatternMatrix PatternMatrix::loadOrBuild(const std::string& wordsPath,
+                                         const Dictionary& words,
+                                         int threads) {
+    PatternMatrix m;
+    if (words.empty()) return m;
+    std::string path = cachePath(wordsPath, words.length());
+    if (m.load(path, words)) return m;
+    m.build(words, threads);
+    if (!m.save(path)) {
+        std::fprintf(stderr, "pattern cache: could not write %s\n", path.c_str());
+    }
+    return m;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Dictionary.hpp"
+#include "MappedFile.hpp"
+#include "Pattern.hpp"
+#include <string>
+#include <vector>
+
+// Guess x answer feedback table over one dictionary: at(g, a) is the
+// pattern shown when words[g] is guessed and words[a] is the secret.
+// Cells are 1 byte for lengths <= 5 and 2 bytes for length 6. The table
+// either lives on the heap (fresh build) or is mapped from a cache file.
+class PatternMatrix {
+public:
+    PatternMatrix() = default;
+
+    // Compute every cell, split across `threads` workers (0 = all cores).
+    void build(const Dictionary& words, int threads = 0);
+
+    // Cache file format: header followed by size()*size() cells.
+    bool save(const std::string& path) const;
+    // Maps `path` if its header matches `words` (same length, order, hash).
+    bool load(const std::string& path, const Dictionary& words);
+
+    // Map the cache next to `wordsPath`, or build and write it.
+    static PatternMatrix loadOrBuild(const std::string& wordsPath,
+                                     const Dictionary& words,
+                                     int threads = 0);
+    static std::string cachePath(const std::string& wordsPath, int len);
+    static uint64_t hashWords(const Dictionary& words);
+
+    bool empty() const { return m_count == 0; }
+    size_t size() const { return m_count; }
+    int length() const { return m_len; }
+    int cellBytes() const { return m_cellBytes; }
+    bool mapped() const { return m_file.isOpen(); }
+
+    Pattern at(size_t guess, size_t answer) const {
+        size_t i = guess * m_count + answer;
+        return m_cellBytes == 1 ? m_cells[i] : ((const uint16_t*)m_cells)[i];
+    }
+    // one guess against every answer; cellBytes() wide
+    const uint8_t* row(size_t guess) const { return m_cells + guess * m_count * m_cellBytes; }
+
+private:
+    struct Header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t length;
+        uint64_t count;
+        uint64_t dictHash;
+        uint32_t cellBytes;
+        uint32_t reserved;
+    };
+    static constexpr uint32_t kVersion = 1;
+
+    int m_len = 0;
+    int m_cellBytes = 1;
+    size_t m_count = 0;
+    uint64_t m_hash = 0;
+    const uint8_t* m_cells = nullptr;
+    std::vector<uint8_t> m_owned;
+    MappedFile m_file;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Wire format between cipher-server and its clients (cipher-load). Every
+// message is a 2-byte header, op then payload length, followed by at most
+// 255 payload bytes; integers are little endian. Each request gets exactly
+// one reply, in order.
+//
+//   NewGame  -> u8 length, u8 attempts, u8 boards, u8 flags (kDaily | kAdversarial)
+//            <- u8 length, u8 rows, u8 boards, u32 candidates
+//   Guess    -> the letters, exactly the game's word length (else TooShort)
+//            <- u8 SubmitResult, u8 status, u8 boards, u16 pattern x boards,
+//               u32 candidates left on board 0
+//   Stats    -> (empty)
+//            <- u32 total, wins, current streak, max streak
+//   Quit     -> (empty); the server closes after replying with an empty Quit
+//   Error    <- text; sent for malformed requests, then the server closes
+namespace Protocol {
+    enum Op : uint8_t { NewGame = 'N', Guess = 'G', Stats = 'S', Quit = 'Q', Error = 'E' };
+    enum Status : uint8_t { Playing = 0, Won = 1, Lost = 2 };
+    constexpr uint8_t kDaily = 1, kAdversarial = 2;
+
+    constexpr size_t kHeader = 2;
+    constexpr size_t kMaxPayload = 255;
+    constexpr size_t kMaxMessage = kHeader + kMaxPayload;
+    constexpr int kDefaultPort = 7645;
+
+    // Bytes of the first complete message at `p`, or 0 if more are needed.
+    inline size_t complete(const uint8_t* p, size_t n) {
+        if (n < kHeader) return 0;
+        size_t total = kHeader + p[1];
+        return n >= total ? total : 0;
+    }
+
+    // Appends fields to a message under construction; finish() fills in
+    // the header. The caller provides kMaxMessage bytes.
+    class Writer {
+    public:
+        Writer(uint8_t* out, Op op) : m_out(out), m_n(kHeader) { out[0] = op; }
+        Writer& u8(uint8_t v) { m_out[m_n++] = v; return *this; }
+        Writer& u16(uint16_t v) { u8((uint8_t)v); return u8((uint8_t)(v >> 8)); }
+        Writer& u32(uint32_t v) { u16((uint16_t)v); return u16((uint16_t)(v >> 16)); }
+        Writer& bytes(const void* p, size_t n) { std::memcpy(m_out + m_n, p, n); m_n += n; return *this; }
+        size_t finish() { m_out[1] = (uint8_t)(m_n - kHeader); return m_n; }
+    private:
+        uint8_t* m_out;
+        size_t m_n;
+    };
+
+    // Reads a payload front to back; ok() turns false on any overrun.
+    class Reader {
+    public:
+        Reader(const uint8_t* p, size_t n) : m_p(p), m_n(n) {}
+        uint8_t u8() { if (m_at + 1 > m_n) { m_ok = false; return 0; } return m_p[m_at++]; }
+        uint16_t u16() { uint16_t lo = u8(); return (uint16_t)(lo | (u8() << 8)); }
+        uint32_t u32() { uint32_t lo = u16(); return lo | ((uint32_t)u16() << 16); }
+        bool ok() const { return m_ok; }
+        size_t left() const { return m_n - m_at; }
+    private:
+        const uint8_t* m_p;
+        size_t m_n, m_at = 0;
+        bool m_ok = true;
+    };
+}
@@ -0,0 +1,44 @@
+#include "Rules.hpp"
+#include "Pattern.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+std::string Rules::toUpper(const std::string& s) {
+    std::string t = s;
+    for (auto& c : t) c = (char)std::toupper((unsigned char)c);
+    return t;
+}
+bool Rules::isAlpha(const std::string& s) {
+    return std::all_of(s.begin(), s.end(), [](unsigned char c){ return std::isalpha(c); });
+}
+char Rules::caesarShiftChar(char c, int k) {
+    if (c < 'A' || c > 'Z') return c;
+    int x = c - 'A';
+    x = (x + k) % 26;
+    return (char)('A' + x);
+}
+std::string Rules::caesarShift(const std::string& s, int k) {
+    std::string o; o.reserve(s.size());
+    for (char c : s) o.push_back(caesarShiftChar(c, k));
+    return o;
+}
+uint64_t Rules::dailySeed() {
+    using namespace std::chrono;
+    auto now = system_clock::now();
+    auto days = duration_cast<hours>(now.time_since_epoch()).count() / 24;
+    uint64_t x = (uint64_t)days;
+    x ^= (x << 23); x ^= (x >> 17); x ^= (x << 5);
+    return x;
+}
+
+void Rules::evaluate(const std::string& secret, const std::string& guess, TileState* out) {
+    const int n = (int)secret.size();
+    Patterns::decode(Patterns::score(secret.data(), guess.data(), n), n, out);
+}
+
+std::vector<TileState> Rules::evaluate(const std::string& secret, const std::string& guess) {
+    std::vector<TileState> out(secret.size(), TileState::Absent);
+    evaluate(secret, guess, out.data());
+    return out;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class TileState : int { Absent = 0, Present = 1, Correct = 2 };
+
+namespace Rules {
+    std::string toUpper(const std::string& s);
+    bool isAlpha(const std::string& s);
+    char caesarShiftChar(char c, int k);
+    std::string caesarShift(const std::string& s, int k);
+    uint64_t dailySeed(); // days since epoch
+
+    // Score `guess` against `secret` (same length, uppercase A-Z).
+    // Greens first, then yellows limited by the remaining letter counts.
+    void evaluate(const std::string& secret, const std::string& guess, TileState* out);
+    std::vector<TileState> evaluate(const std::string& secret, const std::string& guess);
+}
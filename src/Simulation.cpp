@@ -0,0 +1,101 @@
+#include "Simulation.hpp"
+#include "PatternMatrix.hpp"
+#include "Solver.hpp"
+#include "StatsJournal.hpp"
+#include "Strategy.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    // `words` has already loaded the dictionary; shards only read it
+    void playShard(const SimOptions& opt, const GameState& words, const Solver* solver, int opener,
+                   uint64_t begin, uint64_t end, uint64_t shardSeed, Stats& out,
+                   std::vector<StatsJournal::Record>* journal) {
+        GameState g(shardSeed);
+        g.shareWords(words);
+        g.newGame(opt.cfg);
+        const size_t secrets = g.dictionary().size();
+        auto bot = Strategy::make(opt.strategy, solver, opener);
+        std::mt19937_64 rng(shardSeed ^ 0x9E3779B97F4A7C15ull);
+
+        for (uint64_t k=begin; k<end; ++k) {
+            g.newGame(opt.cfg, (size_t)(k % secrets));
+            while (!g.finished()) {
+                std::string_view w = g.dictionary()[bot->nextGuess(g, rng)];
+                for (char c : w) g.typeLetter(c);
+                if (g.submit() != SubmitResult::Accepted) break;
+            }
+            if (journal) journal->push_back(StatsJournal::fromGame(g, StatsJournal::Bot, (int64_t)std::time(nullptr)));
+        }
+        out = g.stats();
+    }
+}
+
+SimResult runSimulation(const SimOptions& opt) {
+    SimResult res;
+    auto t0 = std::chrono::steady_clock::now();
+
+    GameState probe(opt.seed);
+    probe.setWordsPath(opt.wordsPath);
+    probe.newGame(opt.cfg);
+    const Dictionary dict = probe.dictionary();
+    res.secrets = dict.size();
+    res.games = (uint64_t)dict.size() * (uint64_t)std::max(1, opt.rounds);
+
+    // entropy bots share one read-only solver and a precomputed opener
+    std::unique_ptr<PatternMatrix> matrix;
+    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<Solver> solver;
+    int opener = -1;
+    if (opt.strategy == "entropy") {
+        matrix = std::make_unique<PatternMatrix>(PatternMatrix::loadOrBuild(opt.wordsPath, dict, opt.threads));
+        pool = std::make_unique<ThreadPool>(opt.threads);
+        solver = std::make_unique<Solver>(dict, *matrix, *pool);
+        std::vector<int> all(dict.size());
+        for (size_t i=0; i<all.size(); ++i) all[i] = (int)i;
+        opener = solver->best(all, Solver::Options{}).guess;
+    }
+    if (!Strategy::make(opt.strategy, solver.get(), opener)) {
+        res.error = "unknown strategy: " + opt.strategy;
+        return res;
+    }
+
+    int threads = opt.threads > 0 ? opt.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = (int)std::min<uint64_t>((uint64_t)threads, std::max<uint64_t>(1, res.games));
+    std::vector<Stats> shards(threads);
+    // journal records are buffered per shard and appended in game order
+    StatsJournal journal;
+    if (!opt.journal.empty() && !journal.open(opt.journal)) {
+        res.error = "cannot open stats journal " + opt.journal;
+        return res;
+    }
+    std::vector<std::vector<StatsJournal::Record>> records(journal.isOpen() ? threads : 0);
+    std::vector<std::thread> workers;
+    uint64_t chunk = (res.games + threads - 1) / threads;
+    for (int t=0; t<threads; ++t) {
+        uint64_t b = t * chunk, e = std::min(res.games, b + chunk);
+        workers.emplace_back(playShard, std::cref(opt), std::cref(probe), solver.get(), opener, b, e,
+                             opt.seed + 0x1000003ull * (uint64_t)(t + 1), std::ref(shards[t]),
+                             journal.isOpen() ? &records[t] : nullptr);
+    }
+    for (auto& w : workers) w.join();
+
+    for (const Stats& s : shards) res.stats.merge(s);
+    for (auto& shard : records) {
+        for (const StatsJournal::Record& r : shard) journal.append(r);
+        res.journaled += shard.size();
+        shard.clear(); shard.shrink_to_fit();
+    }
+    if (journal.isOpen()) {
+        journal.flush();
+        if (journal.wantsCompaction()) journal.compact();
+        res.journalTotal = journal.records();
+    }
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return res;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "GameState.hpp"
+#include <cstdint>
+#include <string>
+
+struct SimOptions {
+    GameConfig cfg{};
+    std::string wordsPath = "assets/words.txt";
+    std::string strategy = "entropy";
+    int rounds = 1;      // games per secret
+    int threads = 0;     // 0 = all cores
+    uint64_t seed = 1;
+    std::string journal; // StatsJournal base path every game is appended to, or empty
+};
+
+struct SimResult {
+    Stats stats;         // merged in game order across shards
+    uint64_t games = 0;
+    double seconds = 0.0;
+    size_t secrets = 0;
+    uint64_t journaled = 0; // records appended to opt.journal
+    uint64_t journalTotal = 0;
+    std::string error;   // non-empty if the run could not start
+};
+
+// Plays rounds x every secret in the dictionary with a bot strategy. Games
+// are split into contiguous shards, one thread and one GameState (with its
+// own Stats) per shard, and the shard stats are merged in order at the end.
+// The word list, its indexes and hint book are loaded once and shared
+// read-only by every shard.
+SimResult runSimulation(const SimOptions& opt);
@@ -0,0 +1,174 @@
+#include "Solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace {
+    // Sum of c*log2(c) over the bucket sizes of one guess. Large sets sweep
+    // the whole histogram; small ones only read back (and clear) the buckets
+    // they touched.
+    template <typename Cell>
+    double bucketMass(const Cell* row, const std::vector<int>& cands, const double* clogc, int buckets) {
+        uint32_t counts[Patterns::count(Patterns::kMaxLength)];
+        if ((int)cands.size() >= buckets) {
+            std::fill(counts, counts + buckets, 0u);
+            for (int a : cands) counts[row[a]]++;
+            double sum = 0.0;
+            for (int p=0;p<buckets;++p) sum += clogc[counts[p]];
+            return sum;
+        }
+        for (int a : cands) counts[row[a]] = 0;
+        for (int a : cands) counts[row[a]]++;
+        double sum = 0.0;
+        for (int a : cands) {
+            uint32_t& c = counts[row[a]];
+            if (c) { sum += clogc[c]; c = 0; }
+        }
+        return sum;
+    }
+
+    bool better(const Solver::Choice& a, bool aCand, const Solver::Choice& b, bool bCand) {
+        if (b.guess < 0) return true;
+        if (std::fabs(a.score - b.score) > 1e-9) return a.score > b.score;
+        if (aCand != bCand) return aCand; // a candidate might win outright
+        return a.guess < b.guess;
+    }
+}
+
+Solver::Solver(const Dictionary& words, const PatternMatrix& matrix, ThreadPool& pool)
+    : m_words(words), m_matrix(matrix), m_pool(pool), m_clogc(words.size() + 1, 0.0) {
+    for (size_t c=2; c<m_clogc.size(); ++c) m_clogc[c] = (double)c * std::log2((double)c);
+}
+
+double Solver::entropy(int guess, const std::vector<int>& cands) const {
+    if (cands.size() <= 1) return 0.0;
+    const int buckets = Patterns::count(m_matrix.length());
+    double sum = m_matrix.cellBytes() == 1
+        ? bucketMass(m_matrix.row(guess), cands, m_clogc.data(), buckets)
+        : bucketMass((const uint16_t*)m_matrix.row(guess), cands, m_clogc.data(), buckets);
+    const double n = (double)cands.size();
+    return std::log2(n) - sum / n;
+}
+
+Solver::Choice Solver::bestDepth1(const std::vector<int>& cands, std::vector<Choice>* shortlist, int topK) const {
+    Choice best;
+    if (cands.empty()) return best;
+    if (cands.size() <= 2 && !shortlist) {
+        // guessing either one splits the pair (or wins)
+        best.guess = cands[0];
+        best.score = cands.size() == 2 ? 1.0 : 0.0;
+        return best;
+    }
+
+    const size_t G = m_words.size();
+    std::vector<char> isCand(G, 0);
+    for (int a : cands) isCand[a] = 1;
+
+    std::vector<double> scores(G);
+    m_pool.parallelFor(G, 256, [&](size_t b, size_t e) {
+        for (size_t g=b; g<e; ++g) scores[g] = entropy((int)g, cands);
+        m_scored += e - b;
+    });
+
+    for (size_t g=0; g<G; ++g) {
+        Choice c{(int)g, scores[g]};
+        if (better(c, isCand[g], best, best.guess >= 0 && isCand[best.guess])) best = c;
+    }
+    if (shortlist) {
+        std::vector<int> order(G);
+        for (size_t g=0; g<G; ++g) order[g] = (int)g;
+        size_t k = std::min<size_t>(G, (size_t)std::max(1, topK));
+        std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](int a, int b) {
+            return better({a, scores[a]}, isCand[a], {b, scores[b]}, isCand[b]);
+        });
+        shortlist->clear();
+        for (size_t i=0; i<k; ++i) shortlist->push_back({order[i], scores[order[i]]});
+    }
+    return best;
+}
+
+void Solver::partition(int guess, const std::vector<int>& cands,
+                       std::vector<std::pair<Pattern, std::vector<int>>>& out) const {
+    out.clear();
+    std::vector<int> slot(Patterns::count(m_matrix.length()), -1);
+    for (int a : cands) {
+        Pattern p = m_matrix.at(guess, a);
+        if (slot[p] < 0) { slot[p] = (int)out.size(); out.push_back({p, {}}); }
+        out[slot[p]].second.push_back(a);
+    }
+    std::sort(out.begin(), out.end(), [](const auto& x, const auto& y){ return x.first < y.first; });
+}
+
+Solver::Choice Solver::best(const std::vector<int>& cands, const Options& opt) const {
+    if (opt.depth < 2 || cands.size() <= 2) return bestDepth1(cands, nullptr, 0);
+
+    std::vector<Choice> shortlist;
+    bestDepth1(cands, &shortlist, opt.topK);
+
+    const Pattern solved = Patterns::solved(m_matrix.length());
+    const double n = (double)cands.size();
+    std::vector<std::pair<Pattern, std::vector<int>>> buckets;
+    Choice best;
+    bool bestCand = false;
+    for (const Choice& first : shortlist) {
+        partition(first.guess, cands, buckets);
+        double follow = 0.0;
+        bool isCand = false;
+        for (const auto& [p, b] : buckets) {
+            if (p == solved) { isCand = true; continue; }
+            double h2 = b.size() <= 2 ? std::log2((double)b.size())
+                                      : bestDepth1(b, nullptr, 0).score;
+            follow += (double)b.size() / n * h2;
+        }
+        Choice c{first.guess, first.score + follow};
+        if (better(c, isCand, best, bestCand)) { best = c; bestCand = isCand; }
+    }
+    return best;
+}
+
+int Solver::buildTree(const std::vector<int>& cands, const Options& opt) {
+    m_nodes.clear();
+    if (cands.empty()) return -1;
+    return buildNode(cands, opt);
+}
+
+int Solver::buildNode(const std::vector<int>& cands, const Options& opt) {
+    int id = (int)m_nodes.size();
+    m_nodes.emplace_back();
+    Choice c = best(cands, opt);
+    m_nodes[id].guess = c.guess;
+    m_nodes[id].candidates = (int)cands.size();
+
+    const Pattern solved = Patterns::solved(m_matrix.length());
+    std::vector<std::pair<Pattern, std::vector<int>>> buckets;
+    partition(c.guess, cands, buckets);
+    if (buckets.size() == 1 && buckets[0].first != solved) {
+        // no information: fall back to guessing a candidate so we always progress
+        m_nodes[id].guess = cands[0];
+        partition(cands[0], cands, buckets);
+    }
+    for (auto& [p, b] : buckets) {
+        if (p == solved) continue;
+        int child = buildNode(b, opt);
+        m_nodes[id].children.push_back({p, child});
+    }
+    return id;
+}
+
+void Solver::treeCost(int root, uint64_t& totalGuesses, int& maxGuesses) const {
+    totalGuesses = 0; maxGuesses = 0;
+    if (root >= 0) cost(root, 1, totalGuesses, maxGuesses);
+}
+
+void Solver::cost(int node, int depth, uint64_t& total, int& worst) const {
+    const Node& n = m_nodes[node];
+    int below = 0;
+    for (const auto& ch : n.children) {
+        below += m_nodes[ch.second].candidates;
+        cost(ch.second, depth + 1, total, worst);
+    }
+    if (below < n.candidates) { // the guess itself was one of the candidates
+        total += depth;
+        worst = std::max(worst, depth);
+    }
+}
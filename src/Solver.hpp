@@ -0,0 +1,58 @@
+#pragma once
+#include "PatternMatrix.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Entropy-maximising guess selection over a PatternMatrix. Any dictionary
+// word may be guessed; candidates are the answers still consistent with
+// the feedback so far. Depth 2 re-ranks the best depth-1 guesses by the
+// information the best follow-up guess would add in each bucket.
+class Solver {
+public:
+    struct Options {
+        int depth = 1;   // 1 or 2
+        int topK = 16;   // depth-1 shortlist re-ranked at depth 2
+    };
+    struct Choice {
+        int guess = -1;      // word index
+        double score = 0.0;  // expected bits (depth 2: both guesses)
+    };
+    struct Node {
+        int guess = -1;
+        int candidates = 0;
+        // (pattern, child node index) for every non-solving bucket
+        std::vector<std::pair<Pattern, int>> children;
+    };
+
+    Solver(const Dictionary& words, const PatternMatrix& matrix, ThreadPool& pool);
+
+    // Expected information (bits) from guessing `guess` over `cands`.
+    double entropy(int guess, const std::vector<int>& cands) const;
+    Choice best(const std::vector<int>& cands, const Options& opt) const;
+
+    // Full strategy tree over `cands`; returns the root index into nodes().
+    int buildTree(const std::vector<int>& cands, const Options& opt);
+    const std::vector<Node>& nodes() const { return m_nodes; }
+    // Sum of guesses needed to solve every candidate, and the worst case.
+    void treeCost(int root, uint64_t& totalGuesses, int& maxGuesses) const;
+
+    // number of (guess, candidate set) evaluations so far
+    uint64_t guessesScored() const { return m_scored.load(); }
+
+private:
+    Choice bestDepth1(const std::vector<int>& cands, std::vector<Choice>* shortlist, int topK) const;
+    void partition(int guess, const std::vector<int>& cands,
+                   std::vector<std::pair<Pattern, std::vector<int>>>& out) const;
+    int buildNode(const std::vector<int>& cands, const Options& opt);
+    void cost(int node, int depth, uint64_t& total, int& worst) const;
+
+    const Dictionary& m_words;
+    const PatternMatrix& m_matrix;
+    ThreadPool& m_pool;
+    std::vector<Node> m_nodes;
+    std::vector<double> m_clogc; // c * log2(c) by bucket size
+    mutable std::atomic<uint64_t> m_scored{0};
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed-capacity single-producer / single-consumer queue. push() is only
+// called from one thread and pop() from one other; neither ever blocks or
+// allocates. N must be a power of two.
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+public:
+    // false when full; the item is dropped
+    bool push(const T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == N) return false;
+        m_items[head & (N - 1)] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // false when empty
+    bool pop(T& out) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) return false;
+        out = m_items[tail & (N - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    alignas(64) std::atomic<size_t> m_head{0}; // next slot to write
+    alignas(64) std::atomic<size_t> m_tail{0}; // next slot to read
+    std::array<T, N> m_items{};
+};
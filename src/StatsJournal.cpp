@@ -0,0 +1,255 @@
+#include "StatsJournal.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+    const char kJournalMagic[8] = {'C','P','H','R','J','R','N','L'};
+    const char kSnapMagic[8] = {'C','P','H','R','S','N','A','P'};
+    constexpr uint32_t kVersion = 1;
+
+    struct JournalHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t recordBytes;
+    };
+    static_assert(sizeof(JournalHeader) == sizeof(StatsJournal::Record), "header keeps records aligned");
+
+    struct SnapHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t sources;
+        uint64_t records;    // journal records folded in
+    };
+    struct SnapStats {
+        int32_t total, wins, currentStreak, maxStreak, leadingStreak;
+        uint32_t buckets;    // distribution entries that follow
+    };
+
+    void fold(const StatsJournal::Record* r, size_t n, Stats* stats) {
+        int64_t magic;
+        std::memcpy(&magic, kJournalMagic, sizeof(magic));
+        for (size_t i=0; i<n; ++i) {
+            if (r[i].time == magic) continue; // second header from a racing create
+            unsigned src = r[i].flags >> 4;
+            if (src >= StatsJournal::SourceCount) continue;
+            stats[src].record((r[i].flags & StatsJournal::kWin) != 0, r[i].attempts);
+        }
+    }
+
+    // Records of a mapped journal; a torn last record is left out.
+    size_t journalRecords(const MappedFile& f, const StatsJournal::Record*& first) {
+        JournalHeader h;
+        if (f.size() < sizeof(h)) return 0;
+        std::memcpy(&h, f.data(), sizeof(h));
+        if (std::memcmp(h.magic, kJournalMagic, sizeof(kJournalMagic)) != 0 || h.version != kVersion ||
+            h.recordBytes != sizeof(StatsJournal::Record)) return 0;
+        first = (const StatsJournal::Record*)(f.data() + sizeof(h));
+        return (f.size() - sizeof(h)) / sizeof(StatsJournal::Record);
+    }
+
+    bool readSnapshot(const std::string& path, Stats* stats, uint64_t& records) {
+        MappedFile f;
+        if (!f.open(path) || f.size() < sizeof(SnapHeader)) return false;
+        const uint8_t* p = f.data();
+        const uint8_t* end = p + f.size();
+        SnapHeader h;
+        std::memcpy(&h, p, sizeof(h));
+        if (std::memcmp(h.magic, kSnapMagic, sizeof(kSnapMagic)) != 0 || h.version != kVersion ||
+            h.sources != StatsJournal::SourceCount) return false;
+        p += sizeof(h);
+        Stats loaded[StatsJournal::SourceCount];
+        for (Stats& s : loaded) {
+            SnapStats ss;
+            if ((size_t)(end - p) < sizeof(ss)) return false;
+            std::memcpy(&ss, p, sizeof(ss));
+            p += sizeof(ss);
+            if ((size_t)(end - p) < ss.buckets * sizeof(int32_t)) return false;
+            s.total = ss.total; s.wins = ss.wins;
+            s.currentStreak = ss.currentStreak; s.maxStreak = ss.maxStreak;
+            s.leadingStreak = ss.leadingStreak;
+            s.distribution.assign(ss.buckets, 0);
+            std::memcpy(s.distribution.data(), p, ss.buckets * sizeof(int32_t));
+            p += ss.buckets * sizeof(int32_t);
+        }
+        for (int i=0; i<StatsJournal::SourceCount; ++i) stats[i] = std::move(loaded[i]);
+        records = h.records;
+        return true;
+    }
+
+    bool writeSnapshot(const std::string& path, const Stats* stats, uint64_t records) {
+        SnapHeader h{};
+        std::memcpy(h.magic, kSnapMagic, sizeof(kSnapMagic));
+        h.version = kVersion;
+        h.sources = StatsJournal::SourceCount;
+        h.records = records;
+
+        // unique temp name: another process may be compacting the same store
+        std::string tmp = path + ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write((const char*)&h, sizeof(h));
+            for (int i=0; i<StatsJournal::SourceCount; ++i) {
+                const Stats& s = stats[i];
+                SnapStats ss{s.total, s.wins, s.currentStreak, s.maxStreak, s.leadingStreak,
+                             (uint32_t)s.distribution.size()};
+                out.write((const char*)&ss, sizeof(ss));
+                out.write((const char*)s.distribution.data(), (std::streamsize)(s.distribution.size() * sizeof(int32_t)));
+            }
+            if (!out) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) { std::filesystem::remove(tmp, ec); return false; }
+        return true;
+    }
+
+    // Cuts a record torn by a crash or a short write so appends stay aligned.
+    void dropTornRecord(const std::string& journalPath) {
+        std::error_code ec;
+        uintmax_t size = std::filesystem::file_size(journalPath, ec);
+        if (ec || size <= sizeof(JournalHeader)) return;
+        uintmax_t torn = (size - sizeof(JournalHeader)) % sizeof(StatsJournal::Record);
+        if (torn) std::filesystem::resize_file(journalPath, size - torn, ec);
+    }
+
+    // snapshot on disk + every journal record after it -> new snapshot
+    bool compactFiles(const std::string& journalPath, const std::string& snapPath, uint64_t& covered) {
+        Stats stats[StatsJournal::SourceCount];
+        uint64_t from = 0;
+        if (!readSnapshot(snapPath, stats, from)) from = 0;
+        MappedFile f;
+        if (!f.open(journalPath)) return false;
+        const StatsJournal::Record* recs = nullptr;
+        size_t n = journalRecords(f, recs);
+        if (from > n) { // snapshot from another journal: start over
+            for (Stats& s : stats) s = Stats{};
+            from = 0;
+        }
+        if (from == n) { covered = n; return true; }
+        fold(recs + from, n - from, stats);
+        if (!writeSnapshot(snapPath, stats, n)) return false;
+        covered = n;
+        return true;
+    }
+}
+
+StatsJournal::Record StatsJournal::fromGame(const GameState& g, Source source, int64_t time) {
+    const GameConfig& cfg = g.config();
+    Record r{};
+    r.time = time;
+    long secret = g.dictionary().find(g.secret());
+    r.secret = secret < 0 ? 0xFFFFFFFFu : (uint32_t)secret;
+    r.length = (uint8_t)cfg.length;
+    r.attempts = (uint8_t)(g.won() ? g.rowIndex() + 1 : g.rows());
+    r.flags = (uint8_t)((g.won() ? kWin : 0) | (cfg.daily ? kDaily : 0) |
+                        (cfg.adversarial ? kAdversarial : 0) | (source << 4));
+    r.boards = (uint8_t)g.boards();
+    return r;
+}
+
+bool StatsJournal::open(const std::string& base) {
+    namespace fs = std::filesystem;
+    close();
+    m_journalPath = base + ".journal";
+    m_snapPath = base + ".snap";
+
+    std::error_code ec;
+    uintmax_t size = fs::file_size(m_journalPath, ec);
+    if (ec) size = 0;
+    if (size > 0) {
+        // refuse to append to something that is not a journal
+        MappedFile f;
+        const Record* recs = nullptr;
+        if (!f.open(m_journalPath) || (journalRecords(f, recs) == 0 && size != sizeof(JournalHeader))) return false;
+    }
+    dropTornRecord(m_journalPath);
+
+    m_out = std::fopen(m_journalPath.c_str(), "ab");
+    if (!m_out) return false;
+    std::setvbuf(m_out, nullptr, _IONBF, 0); // flush() already batches
+    if (size == 0) {
+        JournalHeader h{};
+        std::memcpy(h.magic, kJournalMagic, sizeof(kJournalMagic));
+        h.version = kVersion;
+        h.recordBytes = sizeof(Record);
+        std::fwrite(&h, sizeof(h), 1, m_out);
+    }
+
+    for (Stats& s : m_stats) s = Stats{};
+    uint64_t covered = 0;
+    if (!readSnapshot(m_snapPath, m_stats, covered)) covered = 0;
+    MappedFile f;
+    const Record* recs = nullptr;
+    size_t n = f.open(m_journalPath) ? journalRecords(f, recs) : 0;
+    if (covered > n) { // snapshot from another journal
+        for (Stats& s : m_stats) s = Stats{};
+        covered = 0;
+    }
+    fold(recs + covered, n - covered, m_stats);
+    m_records = n;
+    m_snapRecords = covered;
+    m_pending.reserve(kBatch);
+    return true;
+}
+
+void StatsJournal::close() {
+    if (!m_out) return;
+    flush();
+    wait();
+    std::fclose(m_out);
+    m_out = nullptr;
+}
+
+void StatsJournal::append(const Record& r) {
+    if (!m_out) return;
+    unsigned src = r.flags >> 4;
+    if (src < SourceCount) m_stats[src].record((r.flags & kWin) != 0, r.attempts);
+    m_pending.push_back(r);
+    ++m_records;
+    if (m_pending.size() >= kBatch) flush();
+}
+
+bool StatsJournal::flush() {
+    if (!m_out || m_pending.empty()) return m_out != nullptr;
+    size_t n = std::fwrite(m_pending.data(), sizeof(Record), m_pending.size(), m_out);
+    if (n == m_pending.size()) {
+        m_pending.clear();
+        return true;
+    }
+    // short write: keep the unwritten records for the next flush and cut any
+    // partly written one ("ab" appends land at the new end)
+    m_pending.erase(m_pending.begin(), m_pending.begin() + (std::ptrdiff_t)n);
+    std::clearerr(m_out);
+    dropTornRecord(m_journalPath);
+    return false;
+}
+
+bool StatsJournal::compact() {
+    if (!m_out) return false;
+    flush();
+    wait();
+    uint64_t covered = 0;
+    if (!compactFiles(m_journalPath, m_snapPath, covered)) return false;
+    m_snapRecords = covered;
+    return true;
+}
+
+void StatsJournal::compactAsync() {
+    if (!m_out || m_compacting) return;
+    wait(); // reap the previous, finished run
+    flush();
+    m_compacting = true;
+    m_compactor = std::thread([this, journal = m_journalPath, snap = m_snapPath] {
+        uint64_t covered = 0;
+        if (compactFiles(journal, snap, covered)) m_snapRecords = covered;
+        m_compacting = false;
+    });
+}
+
+void StatsJournal::wait() {
+    if (m_compactor.joinable()) m_compactor.join();
+}
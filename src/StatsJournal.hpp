@@ -0,0 +1,78 @@
+#pragma once
+#include "GameState.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Persistent Stats: every finished game is appended to `<base>.journal` as a
+// fixed-size record, and `<base>.snap` holds the Stats folded from a prefix
+// of that journal. Opening reads the snapshot and folds only the records
+// after it; compaction folds the tail into a fresh snapshot. The journal
+// itself is never rewritten, so several processes (the game, simulation
+// runs) can append to the same store at once.
+//
+// Journal layout (little endian): 16-byte header, then Record x n. Each
+// flush is a single append of whole records.
+class StatsJournal {
+public:
+    enum Source : uint8_t { Player = 0, Bot = 1, SourceCount };
+
+    struct Record {
+        int64_t  time;       // unix seconds
+        uint32_t secret;     // index into the dictionary of `length`
+        uint8_t  length;
+        uint8_t  attempts;   // rows used; every row on a loss
+        uint8_t  flags;      // kWin | kDaily | kAdversarial | source << 4
+        uint8_t  boards;
+    };
+    static_assert(sizeof(Record) == 16, "journal records are 16 bytes");
+    static constexpr uint8_t kWin = 1, kDaily = 2, kAdversarial = 4;
+
+    // Record for the game `g` just finished.
+    static Record fromGame(const GameState& g, Source source, int64_t time);
+
+    StatsJournal() = default;
+    ~StatsJournal() { close(); }
+    StatsJournal(const StatsJournal&) = delete;
+    StatsJournal& operator=(const StatsJournal&) = delete;
+
+    // Creates the journal if needed and rebuilds stats() from snapshot + tail.
+    bool open(const std::string& base);
+    void close(); // flushes and waits for compaction
+    bool isOpen() const { return m_out != nullptr; }
+
+    // Every game in the journal when it was opened plus those appended since.
+    const Stats& stats(Source s) const { return m_stats[s]; }
+    uint64_t records() const { return m_records; }
+    // records not yet covered by the snapshot file
+    uint64_t tail() const { return m_records - m_snapRecords.load(); }
+    // long enough that the next open would be faster after compact()
+    bool wantsCompaction() const { return tail() >= kCompactTail; }
+
+    // Buffered; flush() writes everything pending as one append. It returns
+    // false on a short write and keeps the records that did not make it.
+    void append(const Record& r);
+    bool flush();
+
+    // Fold the journal into a new snapshot; stats() is not affected.
+    bool compact();
+    // Same on a background thread; no-op while one is running.
+    void compactAsync();
+    void wait();
+
+private:
+    static constexpr size_t kBatch = 4096;
+    static constexpr uint64_t kCompactTail = 1 << 16;
+
+    std::string m_journalPath, m_snapPath;
+    std::FILE* m_out = nullptr;
+    std::vector<Record> m_pending;
+    Stats m_stats[SourceCount];
+    uint64_t m_records = 0;              // flushed + pending
+    std::atomic<uint64_t> m_snapRecords{0};
+    std::atomic<bool> m_compacting{false};
+    std::thread m_compactor;
+};
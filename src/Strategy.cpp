@@ -0,0 +1,91 @@
+#include "Strategy.hpp"
+#include "Solver.hpp"
+#include <vector>
+
+bool Strategy::matchesReveals(const GameState& g, std::string_view w) {
+    for (int i=0; i<g.config().length; ++i)
+        if (g.revealed(i) && w[i] != g.secret()[i]) return false;
+    return true;
+}
+
+namespace {
+    // Uniformly random surviving candidate.
+    class RandomStrategy : public Strategy {
+    public:
+        const char* name() const override { return "random"; }
+        size_t nextGuess(const GameState& g, std::mt19937_64& rng) override {
+            m_pool.clear();
+            const Dictionary& dict = g.dictionary();
+            g.candidates().forEach([&](size_t i) {
+                if (matchesReveals(g, dict[i])) m_pool.push_back(i);
+            });
+            if (m_pool.empty()) return 0;
+            std::uniform_int_distribution<size_t> d(0, m_pool.size() - 1);
+            return m_pool[d(rng)];
+        }
+    private:
+        std::vector<size_t> m_pool;
+    };
+
+    // Alphabetically first surviving candidate; fully deterministic.
+    class FirstStrategy : public Strategy {
+    public:
+        const char* name() const override { return "first"; }
+        size_t nextGuess(const GameState& g, std::mt19937_64&) override {
+            size_t pick = 0;
+            bool found = false;
+            const Dictionary& dict = g.dictionary();
+            g.candidates().forEach([&](size_t i) {
+                if (!found && matchesReveals(g, dict[i])) { pick = i; found = true; }
+            });
+            return pick;
+        }
+    };
+
+    // Follows the hint book while the game stays on it, then falls back to
+    // the first surviving candidate.
+    class BookStrategy : public FirstStrategy {
+    public:
+        const char* name() const override { return "book"; }
+        size_t nextGuess(const GameState& g, std::mt19937_64& rng) override {
+            long i = g.bookHint().empty() ? -1 : g.dictionary().find(g.bookHint());
+            return i >= 0 ? (size_t)i : FirstStrategy::nextGuess(g, rng);
+        }
+    };
+
+    // Precomputed opener, then the candidate with the most expected
+    // information over the remaining candidates.
+    class EntropyStrategy : public Strategy {
+    public:
+        EntropyStrategy(const Solver& solver, int opener) : m_solver(solver), m_opener(opener) {}
+        const char* name() const override { return "entropy"; }
+        size_t nextGuess(const GameState& g, std::mt19937_64&) override {
+            if (g.rowIndex() == 0 && m_opener >= 0) return (size_t)m_opener;
+            m_cands.clear();
+            const Dictionary& dict = g.dictionary();
+            g.candidates().forEach([&](size_t i) {
+                if (matchesReveals(g, dict[i])) m_cands.push_back((int)i);
+            });
+            if (m_cands.size() <= 2) return m_cands.empty() ? 0 : (size_t)m_cands[0];
+            int best = m_cands[0];
+            double bestH = -1.0;
+            for (int c : m_cands) {
+                double h = m_solver.entropy(c, m_cands);
+                if (h > bestH) { bestH = h; best = c; }
+            }
+            return (size_t)best;
+        }
+    private:
+        const Solver& m_solver;
+        int m_opener;
+        std::vector<int> m_cands;
+    };
+}
+
+std::unique_ptr<Strategy> Strategy::make(const std::string& name, const Solver* solver, int opener) {
+    if (name == "random") return std::make_unique<RandomStrategy>();
+    if (name == "first") return std::make_unique<FirstStrategy>();
+    if (name == "book") return std::make_unique<BookStrategy>();
+    if (name == "entropy" && solver) return std::make_unique<EntropyStrategy>(*solver, opener);
+    return nullptr;
+}
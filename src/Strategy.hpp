@@ -0,0 +1,27 @@
+#pragma once
+#include "GameState.hpp"
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+
+class Solver;
+
+// A bot that picks the next guess from what a player can see: the board,
+// the surviving candidates and any revealed letters (never the secret).
+// One instance per thread; instances keep per-game scratch state.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+    virtual const char* name() const = 0;
+    // Index into g.dictionary() of the word to play next.
+    virtual size_t nextGuess(const GameState& g, std::mt19937_64& rng) = 0;
+
+    // "random", "first", "book" (GameState::bookHint) or "entropy" (needs
+    // `solver`); nullptr if unknown.
+    static std::unique_ptr<Strategy> make(const std::string& name, const Solver* solver, int opener);
+
+protected:
+    // Candidate that also agrees with the letters revealed by hints.
+    static bool matchesReveals(const GameState& g, std::string_view w);
+};
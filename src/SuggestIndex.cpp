@@ -0,0 +1,135 @@
+#include "SuggestIndex.hpp"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+
+namespace {
+    // blocks ANDed per pass: each bitmap is read sequentially and the
+    // accumulators stay in L1
+    constexpr size_t kChunk = 64;
+    // fixed + notAt per position, then required, twice and excluded
+    constexpr int kMaxTerms = WordCodes::kMaxLength * 27 + 3 * 26;
+
+    int letter(char c) {
+        int i = std::toupper((unsigned char)c) - 'A';
+        return i >= 0 && i < 26 ? i : -1;
+    }
+
+    uint32_t letterSet(std::string_view s) {
+        uint32_t m = 0;
+        for (char c : s) if (int i = letter(c); i >= 0) m |= 1u << i;
+        return m;
+    }
+}
+
+SuggestIndex::Query SuggestIndex::Query::parse(std::string_view pattern, std::string_view required,
+                                               std::string_view excluded) {
+    Query q;
+    for (size_t p=0; p<pattern.size() && p<(size_t)WordCodes::kMaxLength; ++p)
+        if (int i = letter(pattern[p]); i >= 0) q.fixed[p] = (char)('A' + i);
+    q.required = letterSet(required);
+    q.excluded = letterSet(excluded);
+    return q;
+}
+
+void SuggestIndex::Query::addFeedback(const char* guess, const TileState* states, int len) {
+    int shown[26] = {0};  // green or yellow copies in this guess
+    uint32_t absent = 0;
+    for (int p=0; p<len; ++p) {
+        int c = guess[p] - 'A';
+        if (c < 0 || c >= 26) continue;
+        if (states[p] == TileState::Correct) {
+            fixed[p] = guess[p];
+        } else {
+            notAt[p] |= 1u << c;
+            if (states[p] == TileState::Absent) absent |= 1u << c;
+        }
+        if (states[p] != TileState::Absent) ++shown[c];
+    }
+    for (int c=0; c<26; ++c) {
+        if (shown[c] >= 1) required |= 1u << c;
+        if (shown[c] >= 2) twice |= 1u << c;
+        // a grey copy with no coloured one: the secret has none
+        if (!shown[c] && (absent >> c & 1u)) excluded |= 1u << c;
+    }
+}
+
+void SuggestIndex::Query::setPrefix(std::string_view typed) {
+    for (size_t p=0; p<typed.size() && p<(size_t)WordCodes::kMaxLength; ++p)
+        if (int i = letter(typed[p]); i >= 0) fixed[p] = (char)('A' + i);
+}
+
+bool SuggestIndex::Query::matches(std::string_view word) const {
+    int count[26] = {0};
+    for (size_t p=0; p<word.size(); ++p) {
+        int c = word[p] - 'A';
+        if (c < 0 || c >= 26) return false;
+        if (p < (size_t)WordCodes::kMaxLength && ((fixed[p] && fixed[p] != word[p]) || (notAt[p] >> c & 1u))) return false;
+        ++count[c];
+    }
+    for (int c=0; c<26; ++c) {
+        if ((required >> c & 1u) && count[c] < 1) return false;
+        if ((twice >> c & 1u) && count[c] < 2) return false;
+        if ((excluded >> c & 1u) && count[c] > 0) return false;
+    }
+    return true;
+}
+
+void SuggestIndex::build(const Dictionary& dict) {
+    m_len = dict.length();
+    m_count = dict.size();
+    m_blocks = (m_count + 63) / 64;
+    m_bits.assign((size_t)(m_len + 2) * 26 * m_blocks, 0);
+    for (size_t i=0; i<m_count; ++i) {
+        std::string_view w = dict[i];
+        const uint64_t bit = 1ull << (i & 63);
+        const size_t block = i >> 6;
+        int count[26] = {0};
+        for (int p=0; p<m_len; ++p) {
+            int c = w[p] - 'A';
+            m_bits[((size_t)p * 26 + c) * m_blocks + block] |= bit;
+            ++count[c];
+        }
+        for (int c=0; c<26; ++c) {
+            if (count[c] >= 1) m_bits[((size_t)m_len * 26 + c) * m_blocks + block] |= bit;
+            if (count[c] >= 2) m_bits[((size_t)(m_len + 1) * 26 + c) * m_blocks + block] |= bit;
+        }
+    }
+}
+
+size_t SuggestIndex::query(const Query& q, size_t* out, size_t k) const {
+    if (m_count == 0) return 0;
+    const uint64_t* keep[kMaxTerms];
+    const uint64_t* drop[kMaxTerms];
+    int nk = 0, nd = 0;
+    for (int p=0; p<m_len; ++p) {
+        if (int c = q.fixed[p] - 'A'; q.fixed[p] && c >= 0 && c < 26) keep[nk++] = at(p, c);
+        for (uint32_t m = q.notAt[p]; m; m &= m - 1) drop[nd++] = at(p, std::countr_zero(m));
+    }
+    for (uint32_t m = q.required & ~q.twice & ((1u << 26) - 1); m; m &= m - 1) keep[nk++] = has(std::countr_zero(m));
+    for (uint32_t m = q.twice & ((1u << 26) - 1); m; m &= m - 1) keep[nk++] = twice(std::countr_zero(m));
+    for (uint32_t m = q.excluded & ((1u << 26) - 1); m; m &= m - 1) drop[nd++] = has(std::countr_zero(m));
+
+    const uint64_t tail = (m_count & 63) ? (1ull << (m_count & 63)) - 1 : ~0ull;
+    size_t total = 0, found = 0;
+    uint64_t acc[kChunk];
+    for (size_t b0=0; b0<m_blocks; b0+=kChunk) {
+        const size_t nb = std::min(kChunk, m_blocks - b0);
+        std::fill(acc, acc + nb, ~0ull);
+        for (int t=0; t<nk; ++t) {
+            const uint64_t* bits = keep[t] + b0;
+            for (size_t i=0; i<nb; ++i) acc[i] &= bits[i];
+        }
+        for (int t=0; t<nd; ++t) {
+            const uint64_t* bits = drop[t] + b0;
+            for (size_t i=0; i<nb; ++i) acc[i] &= ~bits[i];
+        }
+        if (b0 + nb == m_blocks) acc[nb - 1] &= tail;
+        for (size_t i=0; i<nb; ++i) {
+            uint64_t bits = acc[i];
+            total += (size_t)std::popcount(bits);
+            for (; bits && found < k; bits &= bits - 1) out[found++] = (b0 + i) * 64 + (size_t)std::countr_zero(bits);
+        }
+    }
+    return total;
+}
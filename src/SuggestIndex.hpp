@@ -0,0 +1,60 @@
+#pragma once
+#include "Dictionary.hpp"
+#include "Rules.hpp"
+#include "WordCode.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Positional-letter bitmaps over one Dictionary for pattern queries such as
+// "?R?N?, containing E, without S or T". Bit i of at(p, c) is set when word
+// i has letter c at position p, of has(c) when it contains c anywhere and of
+// twice(c) when it contains c at least twice. A query ANDs together the
+// bitmaps it names, 64 words per operation, so it costs terms x words / 64
+// however few words match.
+class SuggestIndex {
+public:
+    // Letter sets are bitmasks, bit c for 'A' + c.
+    struct Query {
+        char fixed[WordCodes::kMaxLength] = {};     // letter per position, 0 = any
+        uint32_t notAt[WordCodes::kMaxLength] = {}; // letters ruled out per position
+        uint32_t required = 0;                      // must appear
+        uint32_t twice = 0;                         // must appear at least twice
+        uint32_t excluded = 0;                      // must not appear
+
+        // "?R?N?" ('?', '.', '_' = any letter) plus letter lists
+        static Query parse(std::string_view pattern, std::string_view required = {},
+                           std::string_view excluded = {});
+        // Everything one scored guess says about the secret.
+        void addFeedback(const char* guess, const TileState* states, int len);
+        // Typed letters fill the first positions.
+        void setPrefix(std::string_view typed);
+        bool matches(std::string_view word) const;
+    };
+
+    SuggestIndex() = default;
+    explicit SuggestIndex(const Dictionary& dict) { build(dict); }
+
+    void build(const Dictionary& dict);
+
+    bool empty() const { return m_count == 0; }
+    size_t size() const { return m_count; }
+    int length() const { return m_len; }
+    size_t bytes() const { return m_bits.size() * sizeof(uint64_t); }
+
+    // Indices of the first `k` matching words in dictionary order go to
+    // `out`; returns how many words match in total. No allocation.
+    size_t query(const Query& q, size_t* out, size_t k) const;
+
+private:
+    const uint64_t* at(int p, int c) const { return m_bits.data() + ((size_t)p * 26 + c) * m_blocks; }
+    const uint64_t* has(int c) const { return at(m_len, c); }
+    const uint64_t* twice(int c) const { return at(m_len + 1, c); }
+
+    // [position 0..len-1 | has | twice] x letter x block
+    std::vector<uint64_t> m_bits;
+    size_t m_blocks = 0; // 64-word blocks
+    size_t m_count = 0;
+    int m_len = 0;
+};
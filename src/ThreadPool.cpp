@@ -0,0 +1,124 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace {
+    thread_local const ThreadPool* tlsPool = nullptr;
+    thread_local int tlsIndex = -1;
+}
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    // one queue per worker plus one shared by outside callers
+    for (int i=0;i<=threads;++i) m_queues.push_back(std::make_unique<Queue>());
+    for (int i=0;i<threads;++i) m_workers.emplace_back([this, i]{ workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_workers) t.join();
+}
+
+int ThreadPool::workerIndex() const {
+    return tlsPool == this ? tlsIndex : size();
+}
+
+void ThreadPool::push(Task t) {
+    int self = workerIndex();
+    // workers keep their own tasks local; outside callers spread them out
+    size_t q = self < size() ? (size_t)self : m_next++ % m_queues.size();
+    {
+        std::lock_guard<std::mutex> lk(m_queues[q]->mutex);
+        m_queues[q]->tasks.push_back(std::move(t));
+    }
+    {
+        std::lock_guard<std::mutex> lk(m_sleepMutex);
+        m_pending++;
+    }
+    m_wake.notify_one();
+}
+
+bool ThreadPool::tryRun(int self) {
+    Task task;
+    const int n = (int)m_queues.size();
+    {
+        Queue& own = *m_queues[self];
+        std::lock_guard<std::mutex> lk(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (int k=1; !task && k<n; ++k) {
+        Queue& victim = *m_queues[(self + k) % n];
+        std::lock_guard<std::mutex> lk(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    m_pending--;
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(int self) {
+    tlsPool = this;
+    tlsIndex = self;
+    for (;;) {
+        if (tryRun(self)) continue;
+        std::unique_lock<std::mutex> lk(m_sleepMutex);
+        m_wake.wait(lk, [this]{ return m_stop || m_pending > 0; });
+        if (m_stop && m_pending == 0) return;
+    }
+}
+
+void ThreadPool::parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (n == 0) return;
+    grain = std::max<size_t>(1, grain);
+    size_t chunks = (n + grain - 1) / grain;
+    if (chunks == 1) { fn(0, n); return; }
+
+    // the first exception thrown by any chunk is rethrown here once every
+    // chunk has finished (they all reference this frame)
+    std::atomic<size_t> remaining{chunks};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto runChunk = [&](size_t b, size_t e) {
+        try {
+            fn(b, e);
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+        // the caller may return as soon as it sees the count hit zero, which
+        // destroys this closure (and the `this` it captured), so the wakeup
+        // must not read anything from it after the decrement
+        std::mutex& sleepMutex = m_sleepMutex;
+        std::condition_variable& wake = m_wake;
+        if (--remaining == 0) {
+            // taking the lock orders this with the waiter's predicate check
+            { std::lock_guard<std::mutex> lk(sleepMutex); }
+            wake.notify_all();
+        }
+    };
+    for (size_t c=1; c<chunks; ++c) {
+        size_t b = c * grain, e = std::min(n, b + grain);
+        push([&runChunk, b, e]{ runChunk(b, e); });
+    }
+    // run the first chunk here, then help with queued tasks; sleep while
+    // the last chunks run elsewhere and nothing is queued
+    runChunk(0, std::min(n, grain));
+    int self = workerIndex();
+    while (remaining.load() > 0) {
+        if (tryRun(self)) continue;
+        std::unique_lock<std::mutex> lk(m_sleepMutex);
+        m_wake.wait(lk, [&]{ return remaining.load() == 0 || m_pending > 0; });
+    }
+    if (error) std::rethrow_exception(error);
+}
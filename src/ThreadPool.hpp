@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: every worker owns a deque, pops its own newest task
+// and steals the oldest task from a sibling when it runs dry. Threads that
+// wait on a parallelFor help run tasks, so nested loops never deadlock.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0); // 0 = all cores
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)m_workers.size(); }
+
+    // Run fn(begin, end) over [0, n) in chunks of `grain`, blocking until done.
+    // If chunks throw, the first exception is rethrown after all have finished.
+    void parallelFor(size_t n, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+    // Index of the calling worker in [0, size()), or size() for outside threads.
+    int workerIndex() const;
+
+private:
+    using Task = std::function<void()>;
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task t);
+    bool tryRun(int self);
+    void workerLoop(int self);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_next{0};
+    std::atomic<int> m_pending{0};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
@@ -0,0 +1,77 @@
+#include "Tweens.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+float ease(Ease e, float t) {
+    switch (e) {
+    case Ease::OutCubic: { float u = 1.f - t; return 1.f - u * u * u; }
+    case Ease::InOutSine: return 0.5f - 0.5f * std::cos(t * 3.14159265f);
+    default: return t;
+    }
+}
+
+void Tweens::start(float* value, float to, float seconds, Ease e, float delay,
+                   Done done, void* ctx, uint32_t tag) {
+    m_live.push_back({value, *value, to, 0.f, seconds > 0.f ? 1.f / seconds : INFINITY, delay, e, done, ctx, tag});
+}
+
+void Tweens::retarget(float* value, float to, float seconds, Ease e, float delay,
+                      Done done, void* ctx, uint32_t tag) {
+    for (Tween& w : m_live) {
+        if (w.value != value) continue;
+        w = {value, *value, to, 0.f, seconds > 0.f ? 1.f / seconds : INFINITY, delay, e, done, ctx, tag};
+        return;
+    }
+    start(value, to, seconds, e, delay, done, ctx, tag);
+}
+
+void Tweens::after(float seconds, Done done, void* ctx, uint32_t tag) {
+    m_live.push_back({nullptr, 0.f, 0.f, 0.f, seconds > 0.f ? 1.f / seconds : INFINITY, 0.f,
+                      Ease::Linear, done, ctx, tag});
+}
+
+void Tweens::update(float dt) {
+    // tweens appended by callbacks sit past n and wait for the next update
+    size_t n = m_live.size();
+    for (size_t i=0; i<n; ) {
+        Tween& w = m_live[i];
+        float step = dt;
+        if (w.delay > 0.f) {
+            w.delay -= dt;
+            if (w.delay > 0.f) { ++i; continue; }
+            step = -w.delay;
+            w.delay = 0.f;
+            if (w.value) w.from = *w.value;
+        }
+        w.t += step * w.rate;
+        if (w.t < 1.f) {
+            if (w.value) *w.value = w.from + (w.to - w.from) * ease(w.ease, w.t);
+            ++i;
+            continue;
+        }
+        if (w.value) *w.value = w.to;
+        Done done = w.done;
+        void* ctx = w.ctx;
+        uint32_t tag = w.tag;
+        // retire: last active one into this slot, then the newest into its place
+        --n;
+        m_live[i] = m_live[n];
+        m_live[n] = m_live.back();
+        m_live.pop_back();
+        if (done) {
+            done(ctx, tag);
+            n = std::min(n, m_live.size()); // the callback may have cleared
+        }
+    }
+}
+
+float Tweens::nextWake() const {
+    float wait = std::numeric_limits<float>::infinity();
+    for (const Tween& w : m_live) {
+        if (w.delay > 0.f) wait = std::min(wait, w.delay);
+        else if (w.value) return 0.f;
+        else wait = std::min(wait, (1.f - w.t) / w.rate);
+    }
+    return wait;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class Ease : uint8_t { Linear, OutCubic, InOutSine };
+float ease(Ease e, float t); // t in [0, 1]
+
+// Active-set animation scheduler. Only running tweens are stored, in one
+// dense array: update() costs O(active) and a finished tween is retired by
+// swapping the last one into its slot. A tween drives a float from its
+// current value to a target over a duration (after an optional delay); a
+// timer is a tween with no float and exists only for its callback.
+// Callbacks are plain function pointers so a warm scheduler never allocates.
+class Tweens {
+public:
+    using Done = void (*)(void* ctx, uint32_t tag);
+
+    // Animates *value from where it is now to `to`; `value` must not be
+    // driven by another tween.
+    void start(float* value, float to, float seconds, Ease e = Ease::Linear, float delay = 0.f,
+               Done done = nullptr, void* ctx = nullptr, uint32_t tag = 0);
+    // Same, but replaces the tween already driving `value` if there is one
+    // (found in O(active)).
+    void retarget(float* value, float to, float seconds, Ease e = Ease::Linear, float delay = 0.f,
+                  Done done = nullptr, void* ctx = nullptr, uint32_t tag = 0);
+    // Calls done(ctx, tag) once `seconds` have passed.
+    void after(float seconds, Done done, void* ctx, uint32_t tag = 0);
+
+    // Advances every tween; finished ones land exactly on their target, are
+    // retired, then have their callback run. Callbacks may start or clear
+    // tweens; ones they start first advance on the next update().
+    void update(float dt);
+    // Drops everything without running callbacks.
+    void clear() { m_live.clear(); }
+
+    bool empty() const { return m_live.empty(); }
+    size_t size() const { return m_live.size(); }
+    // Seconds until something visible changes: 0 while a value is moving,
+    // else the nearest delay or timer, +inf when nothing is scheduled.
+    float nextWake() const;
+
+private:
+    struct Tween {
+        float* value;  // nullptr for timers
+        float from, to;
+        float t;       // progress 0..1
+        float rate;    // progress per second
+        float delay;   // seconds left before it starts moving
+        Ease ease;
+        Done done;
+        void* ctx;
+        uint32_t tag;
+    };
+    std::vector<Tween> m_live;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// A word of up to 6 letters packed 5 bits per letter, first letter in the
+// highest bits, so codes of equal-length words sort like the words do.
+using WordCode = uint32_t;
+
+namespace WordCodes {
+    constexpr int kMaxLength = 6;
+    constexpr WordCode kInvalid = 0xFFFFFFFFu;
+
+    constexpr WordCode pack(std::string_view w) {
+        if (w.empty() || (int)w.size() > kMaxLength) return kInvalid;
+        WordCode c = 0;
+        for (char ch : w) {
+            unsigned v = (unsigned)(ch - 'A');
+            if (v >= 26) return kInvalid;
+            c = (c << 5) | v;
+        }
+        return c;
+    }
+
+    constexpr char letter(WordCode c, int len, int i) {
+        return (char)('A' + ((c >> (5 * (len - 1 - i))) & 31u));
+    }
+
+    inline void unpack(WordCode c, int len, char* out) {
+        for (int i=0;i<len;++i) out[i] = letter(c, len, i);
+    }
+}
@@ -0,0 +1,25 @@
+#include "WordIndex.hpp"
+#include <algorithm>
+
+void WordIndex::build(const Dictionary& dict) {
+    std::vector<WordCode> sorted;
+    sorted.reserve(dict.size());
+    for (size_t i=0; i<dict.size(); ++i) {
+        WordCode c = WordCodes::pack(dict[i]);
+        if (c != WordCodes::kInvalid) sorted.push_back(c);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    m_tree.assign(sorted.size() + 1, 0);
+    size_t i = 0;
+    fill(sorted, i, 1);
+}
+
+void WordIndex::fill(const std::vector<WordCode>& sorted, size_t& i, size_t k) {
+    // in-order walk of the implicit tree assigns the sorted codes
+    if (k >= m_tree.size()) return;
+    fill(sorted, i, 2*k);
+    m_tree[k] = sorted[i++];
+    fill(sorted, i, 2*k + 1);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "Dictionary.hpp"
+#include "WordCode.hpp"
+#include <bit>
+#include <vector>
+
+// Membership index over packed word codes in Eytzinger (BFS) order: the
+// search walks one cache line per level near the root and compiles to a
+// loop without data-dependent branches. 4 bytes per word.
+class WordIndex {
+public:
+    WordIndex() = default;
+    explicit WordIndex(const Dictionary& dict) { build(dict); }
+
+    void build(const Dictionary& dict);
+
+    bool contains(WordCode code) const {
+        size_t k = 1;
+        while (k < m_tree.size()) k = 2*k + (m_tree[k] < code);
+        k >>= std::countr_one(k) + 1; // undo the final run of right turns
+        return k != 0 && m_tree[k] == code;
+    }
+    bool contains(std::string_view w) const { return contains(WordCodes::pack(w)); }
+
+    size_t size() const { return m_tree.empty() ? 0 : m_tree.size() - 1; }
+    size_t bytes() const { return m_tree.capacity() * sizeof(WordCode); }
+
+private:
+    void fill(const std::vector<WordCode>& sorted, size_t& i, size_t k);
+
+    std::vector<WordCode> m_tree; // 1-based; slot 0 unused
+};
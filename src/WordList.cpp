@@ -1,66 +1,227 @@
 #include "WordList.hpp"
-#include <fstream>
+#include "MappedFile.hpp"
 #include <algorithm>
-#include <cctype>
-#include <unordered_set>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <thread>
 
-static std::string toUpper(std::string s) {
-    for (auto& c : s) c = (char)std::toupper((unsigned char)c);
-    return s;
-}
-static bool isAlpha(const std::string& s) {
-    return std::all_of(s.begin(), s.end(), [](unsigned char c){ return std::isalpha(c); });
+namespace {
+    // Words of up to 12 letters pack into one sortable key: letters as 1..26
+    // in 5-bit fields from the top down, so shorter prefixes compare lower
+    // and integer order is exactly string order.
+    constexpr int kKeyLetters = 12;
+
+    uint64_t packKey(const char* w, int len) {
+        uint64_t k = 0;
+        for (int i=0;i<len;++i) k |= (uint64_t)(w[i] - 'A' + 1) << (59 - 5 * i);
+        return k;
+    }
+
+    void unpackKey(uint64_t k, std::string& out) {
+        out.clear();
+        for (int i=0;i<kKeyLetters;++i) {
+            unsigned v = (unsigned)(k >> (59 - 5 * i)) & 31u;
+            if (!v) break;
+            out.push_back((char)('A' + v - 1));
+        }
+    }
+
+    struct Chunk {
+        std::vector<uint64_t> keys;
+        std::vector<std::string> longWords; // > kKeyLetters, rare
+    };
+
+    // One newline-delimited slice: validate, uppercase, filter by length.
+    void parseChunk(const char* p, const char* end, int fixedLen, Chunk& out) {
+        char buf[kKeyLetters];
+        while (p < end) {
+            const char* nl = std::find(p, end, '\n');
+            const char* e = nl;
+            if (e > p && e[-1] == '\r') --e; // CRLF lists
+            int len = (int)(e - p);
+            bool ok = len > 0 && (fixedLen <= 0 || len == fixedLen);
+            if (ok && len <= kKeyLetters) {
+                for (int i=0;i<len && ok;++i) {
+                    char c = p[i];
+                    if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+                    ok = c >= 'A' && c <= 'Z';
+                    buf[i] = c;
+                }
+                if (ok) out.keys.push_back(packKey(buf, len));
+            } else if (ok) {
+                std::string w(p, e);
+                for (char& c : w) {
+                    if (c >= 'a' && c <= 'z') c = (char)(c - 'a' + 'A');
+                    ok = ok && c >= 'A' && c <= 'Z';
+                }
+                if (ok) out.longWords.push_back(std::move(w));
+            }
+            p = nl == end ? end : nl + 1; // last line may lack a newline
+        }
+    }
+
+    // LSD radix sort on 60-bit keys, 12 bits per pass; passes where every
+    // key has the same digit (e.g. the empty tail of short words) are skipped.
+    void radixSort(std::vector<uint64_t>& keys) {
+        std::vector<uint64_t> tmp(keys.size());
+        std::vector<size_t> count(4096);
+        for (int shift=4; shift<64; shift+=12) {
+            std::fill(count.begin(), count.end(), 0);
+            for (uint64_t k : keys) count[(k >> shift) & 4095]++;
+            if (std::find(count.begin(), count.end(), keys.size()) != count.end()) continue;
+            size_t sum = 0;
+            for (size_t& c : count) { size_t n = c; c = sum; sum += n; }
+            for (uint64_t k : keys) tmp[count[(k >> shift) & 4095]++] = k;
+            keys.swap(tmp);
+        }
+    }
+
+    template <typename Fn>
+    void parallel(int threads, Fn&& fn) {
+        std::vector<std::thread> pool;
+        for (int t=1;t<threads;++t) pool.emplace_back(fn, t);
+        fn(0);
+        for (auto& th : pool) th.join();
+    }
 }
 
 std::vector<std::string> WordList::loadFromFile(const std::string& path, int fixedLen) {
     std::vector<std::string> out;
-    std::ifstream in(path);
-    if (!in) return out;
-    std::string line;
-    out.reserve(10000);
-    while (std::getline(in, line)) {
-        if (line.empty()) continue;
-        auto w = toUpper(line);
-        if (!isAlpha(w)) continue;
-        if (fixedLen > 0 && (int)w.size() != fixedLen) continue;
-        out.push_back(w);
+    MappedFile file;
+    if (!file.open(path)) return out;
+    const char* begin = (const char*)file.data();
+    const char* end = begin + file.size();
+
+    // split on newline boundaries; small lists stay on this thread
+    const size_t kMinChunk = 1 << 20;
+    int threads = (int)std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                        file.size() / kMinChunk + 1);
+    std::vector<const char*> cuts(threads + 1, end);
+    cuts[0] = begin;
+    for (int t=1;t<threads;++t) {
+        const char* c = std::max(cuts[t-1], begin + file.size() * t / threads);
+        c = std::find(c, end, '\n');
+        cuts[t] = c == end ? end : c + 1;
+    }
+
+    std::vector<Chunk> chunks(threads);
+    parallel(threads, [&](int t) {
+        Chunk& c = chunks[t];
+        c.keys.reserve((size_t)(cuts[t+1] - cuts[t]) / 6);
+        parseChunk(cuts[t], cuts[t+1], fixedLen, c);
+    });
+
+    // one sorted, duplicate-free key list -> canonical (alphabetical) order
+    // regardless of file order, thread count or standard library
+    size_t total = 0;
+    for (const Chunk& c : chunks) total += c.keys.size();
+    std::vector<uint64_t> keys;
+    keys.reserve(total);
+    std::vector<std::string> longWords;
+    for (Chunk& c : chunks) {
+        keys.insert(keys.end(), c.keys.begin(), c.keys.end());
+        std::move(c.longWords.begin(), c.longWords.end(), std::back_inserter(longWords));
+        c = Chunk{};
+    }
+    radixSort(keys);
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    out.resize(keys.size());
+    parallel(threads, [&](int t) {
+        size_t b = keys.size() * t / threads, e = keys.size() * (t + 1) / threads;
+        for (size_t i=b;i<e;++i) unpackKey(keys[i], out[i]);
+    });
+
+    if (!longWords.empty()) {
+        std::sort(longWords.begin(), longWords.end());
+        longWords.erase(std::unique(longWords.begin(), longWords.end()), longWords.end());
+        std::vector<std::string> merged;
+        merged.reserve(out.size() + longWords.size());
+        std::merge(std::make_move_iterator(out.begin()), std::make_move_iterator(out.end()),
+                   std::make_move_iterator(longWords.begin()), std::make_move_iterator(longWords.end()),
+                   std::back_inserter(merged));
+        out.swap(merged);
     }
-    // Deduplicate
-    std::unordered_set<std::string> uniq(out.begin(), out.end());
-    out.assign(uniq.begin(), uniq.end());
     return out;
 }
 
-static const char* builtin4[] = {
-    "CODE","NOVA","WAVE","SIGN","NODE","BYTE","PLOT","JAZZ","TASK","RUST",
-    "DATA","MESH","KERN","HASH","SYNC","PUSH","PULL","VIBE","FLOW","PLAY",
-};
-static const char* builtin5[] = {
-    "APPLE","GRAPE","CRANE","PLANT","PIXEL","ROBOT","FRAME","LIGHT","NERVE","QUANT",
-    "SOLAR","NINJA","LASER","CLOUD","STACK","SMILE","TRACK","SCALE","MUSIC","SHIFT",
-    "PRIME","ALPHA","GAMMA","DELTA","SIGMA","OMEGA","MORSE","CIPHER","RHYME","BRAVE",
-    "TRAIN","CHAIR","WATER","EARTH","METAL","RADIO","PIXIE","VAPOR","SWORD","BRICK",
-    "CROWN","SPARK","SHINE","BLADE","NODES","ARRAY","HEART","BATCH","ENIGM","GHOST",
-    "LEVEL","ROUTE","SHELL","PATCH","QUEUE","MARCH","CHART","SOUND","SWEET","TRAIL"
-};
-static const char* builtin6[] = {
-    "VECTOR","PLAYER","PYTHON","DOCKER","SCALER","FILTER","VISION","SECRET","PUZZLE","TARGET",
-    "STREAM","OBJECT","MEMORY","POCKET","SPRITE","SHADER","SCRIPT","ENGINE","MODULE","SYSTEM",
-    "NUMBER","LOGGER","STATUS","BREACH","CIPHER","SIGNAL","DIRECT","METHOD","STRUCT","OUTPUT",
-    "SCENES","LENGTH","EDGERS","BUFFER","STATEM","FIGURE","CHANCE","TARGET","BROWSE","BINARY"
-};
-
-std::vector<std::string> WordList::loadBuiltin(int fixedLen) {
-    std::vector<std::string> out;
-    if (fixedLen == 4) {
-        out.assign(std::begin(builtin4), std::end(builtin4));
-    } else if (fixedLen == 5) {
-        out.assign(std::begin(builtin5), std::end(builtin5));
-    } else if (fixedLen == 6) {
-        out.assign(std::begin(builtin6), std::end(builtin6));
-    } else {
-        // default to 5
-        out.assign(std::begin(builtin5), std::end(builtin5));
+namespace {
+    // Builtin fallback lists. Each is checked at compile time and packed
+    // into static sorted letters, so Dictionary can use it in place.
+    constexpr const char* kBuiltin4[] = {
+        "CODE","NOVA","WAVE","SIGN","NODE","BYTE","PLOT","JAZZ","TASK","RUST",
+        "DATA","MESH","KERN","HASH","SYNC","PUSH","PULL","VIBE","FLOW","PLAY",
+    };
+    constexpr const char* kBuiltin5[] = {
+        "APPLE","GRAPE","CRANE","PLANT","PIXEL","ROBOT","FRAME","LIGHT","NERVE","QUANT",
+        "SOLAR","NINJA","LASER","CLOUD","STACK","SMILE","TRACK","SCALE","MUSIC","SHIFT",
+        "PRIME","ALPHA","GAMMA","DELTA","SIGMA","OMEGA","MORSE","CRYPT","RHYME","BRAVE",
+        "TRAIN","CHAIR","WATER","EARTH","METAL","RADIO","PIXIE","VAPOR","SWORD","BRICK",
+        "CROWN","SPARK","SHINE","BLADE","NODES","ARRAY","HEART","BATCH","ENIGM","GHOST",
+        "LEVEL","ROUTE","SHELL","PATCH","QUEUE","MARCH","CHART","SOUND","SWEET","TRAIL"
+    };
+    constexpr const char* kBuiltin6[] = {
+        "VECTOR","PLAYER","PYTHON","DOCKER","SCALER","FILTER","VISION","SECRET","PUZZLE","TARGET",
+        "STREAM","OBJECT","MEMORY","POCKET","SPRITE","SHADER","SCRIPT","ENGINE","MODULE","SYSTEM",
+        "NUMBER","LOGGER","STATUS","BREACH","CIPHER","SIGNAL","DIRECT","METHOD","STRUCT","OUTPUT",
+        "SCENES","LENGTH","EDGERS","BUFFER","STATEM","FIGURE","CHANCE","KERNEL","BROWSE","BINARY"
+    };
+
+    template <int Len, size_t N>
+    constexpr bool lettersOfLength(const char* const (&words)[N]) {
+        for (const char* w : words) {
+            int n = 0;
+            for (; w[n]; ++n) if (w[n] < 'A' || w[n] > 'Z') return false;
+            if (n != Len) return false;
+        }
+        return true;
+    }
+
+    template <size_t N>
+    constexpr bool unique(const char* const (&words)[N]) {
+        for (size_t i=0; i<N; ++i)
+            for (size_t j=i+1; j<N; ++j)
+                if (std::string_view(words[i]) == words[j]) return false;
+        return true;
+    }
+
+    // Sorted words back to back, the layout Dictionary expects.
+    template <int Len, size_t N>
+    struct PackedList {
+        char letters[Len * N];
+        constexpr std::string_view view() const { return {letters, sizeof(letters)}; }
+    };
+
+    template <int Len, size_t N>
+    constexpr PackedList<Len, N> pack(const char* const (&words)[N]) {
+        std::array<std::string_view, N> sorted{};
+        for (size_t i=0; i<N; ++i) sorted[i] = words[i];
+        std::sort(sorted.begin(), sorted.end());
+        PackedList<Len, N> out{};
+        for (size_t i=0; i<N; ++i)
+            for (int p=0; p<Len; ++p) out.letters[i * Len + p] = sorted[i][p];
+        return out;
+    }
+
+    static_assert(lettersOfLength<4>(kBuiltin4), "builtin 4-letter list: every word must be 4 letters A-Z");
+    static_assert(lettersOfLength<5>(kBuiltin5), "builtin 5-letter list: every word must be 5 letters A-Z");
+    static_assert(lettersOfLength<6>(kBuiltin6), "builtin 6-letter list: every word must be 6 letters A-Z");
+    static_assert(unique(kBuiltin4), "builtin 4-letter list has a duplicate");
+    static_assert(unique(kBuiltin5), "builtin 5-letter list has a duplicate");
+    static_assert(unique(kBuiltin6), "builtin 6-letter list has a duplicate");
+
+    constexpr auto kPacked4 = pack<4>(kBuiltin4);
+    constexpr auto kPacked5 = pack<5>(kBuiltin5);
+    constexpr auto kPacked6 = pack<6>(kBuiltin6);
+}
+
+std::string_view WordList::builtin(int fixedLen) {
+    switch (fixedLen) {
+    case 4: return kPacked4.view();
+    case 5: return kPacked5.view();
+    case 6: return kPacked6.view();
+    default: return {};
     }
-    return out;
 }
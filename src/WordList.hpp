@@ -1,11 +1,15 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace WordList {
-    // Load from file: uppercase letters only, filter by length if >0
+    // Load from file: uppercase letters only, filter by length if >0.
+    // The file is mapped and parsed in parallel chunks; the result is sorted
+    // and duplicate-free, so it does not depend on file order or platform.
     std::vector<std::string> loadFromFile(const std::string& path, int fixedLen);
 
-    // Builtin fallback lists by length (4..6)
-    std::vector<std::string> loadBuiltin(int fixedLen);
+    // Builtin fallback list by length (4..6; empty otherwise): words packed
+    // back to back, sorted and duplicate-free, in static storage.
+    std::string_view builtin(int fixedLen);
 }
@@ -1,9 +1,27 @@
 #include <SFML/Graphics.hpp>
 #include <imgui.h>
 #include <imgui-SFML.h>
+#include "FrameProfiler.hpp"
 #include "Game.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+int main(int argc, char** argv) {
+    // cipher [--record PATH] [--stats BASE | --no-stats]
+    //   --record: log every input and frame for cipher-replay
+    //   --stats: persistent stats store (BASE.journal + BASE.snap)
+    std::string recordPath, statsBase = "cipher-stats";
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        if (a == "--record" && i+1 < argc) recordPath = argv[++i];
+        else if (a == "--stats" && i+1 < argc) statsBase = argv[++i];
+        else if (a == "--no-stats") statsBase.clear();
+        else { std::fprintf(stderr, "usage: cipher [--record PATH] [--stats BASE | --no-stats]\n"); return 2; }
+    }
 
-int main() {
     sf::RenderWindow window(sf::VideoMode(1000, 800), "Cipher");
     window.setFramerateLimit(60);
     ImGui::SFML::Init(window);
@@ -14,26 +32,85 @@ int main() {
     style.ScrollbarRounding = 8.f;
     style.WindowRounding = 8.f;
 
-    Game game;
+    const uint64_t seed = std::random_device{}();
+    Game game(seed);
+    FrameProfiler prof;
+    game.setProfiler(&prof);
+    InputLog log;
+    if (!recordPath.empty()) {
+        if (!log.create(recordPath, seed, Rules::dailySeed())) {
+            std::fprintf(stderr, "cannot write %s\n", recordPath.c_str());
+            return 1;
+        }
+        game.setRecorder(&log);
+    }
+    StatsJournal journal;
+    if (!statsBase.empty()) {
+        if (journal.open(statsBase)) {
+            game.setJournal(&journal);
+            if (journal.wantsCompaction()) journal.compactAsync();
+        } else {
+            std::fprintf(stderr, "cannot open stats journal %s.journal, stats will not be kept\n", statsBase.c_str());
+        }
+    }
 
     sf::Clock deltaClock;
     bool wantQuit = false;
 
+    auto handle = [&](const sf::Event& event) {
+        ImGui::SFML::ProcessEvent(event);
+        game.noteActivity();
+        if (event.type == sf::Event::Closed) window.close();
+        if (event.type == sf::Event::TextEntered) game.onTextEntered(event.text.unicode);
+        if (event.type == sf::Event::KeyPressed) {
+            if (event.key.code == sf::Keyboard::Escape) wantQuit = true;
+            if (event.key.code == sf::Keyboard::F3) prof.toggle();
+            game.onKeyPressed(event.key.code);
+        }
+    };
+
+    // ImGui needs a couple of frames after an event for hover/menu state to settle
+    const int settleFrames = 3;
+    int settle = settleFrames;
+
     while (window.isOpen() && !wantQuit) {
+        prof.beginFrame();
         sf::Event event{};
-        while (window.pollEvent(event)) {
-            ImGui::SFML::ProcessEvent(event);
-            if (event.type == sf::Event::Closed) window.close();
-            if (event.type == sf::Event::TextEntered) game.onTextEntered(event.text.unicode);
-            if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::Escape) wantQuit = true;
-                game.onKeyPressed(event.key.code);
+        bool gotEvent = false, pending = false;
+
+        // Idle: block until input, or until the game's next scheduled change.
+        // SFML 2.6 waitEvent has no timeout, so timed waits sleep in short slices.
+        if (settle == 0) {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::Idle);
+            float wait = game.redrawIn();
+            if (std::isinf(wait)) {
+                pending = window.waitEvent(event);
+            } else if (wait > 0.f) {
+                sf::Clock idle;
+                while (idle.getElapsedTime().asSeconds() < wait) {
+                    if ((pending = window.pollEvent(event))) break;
+                    float left = wait - idle.getElapsedTime().asSeconds();
+                    sf::sleep(sf::seconds(std::min(left, 0.01f)));
+                }
             }
         }
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::Poll);
+            if (pending) { handle(event); gotEvent = true; }
+            while (window.pollEvent(event)) { handle(event); gotEvent = true; }
+        }
+        if (gotEvent) settle = settleFrames;
+        else if (settle > 0) --settle;
 
         float dt = deltaClock.restart().asSeconds();
-        ImGui::SFML::Update(window, sf::seconds(dt));
-        game.update(dt);
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::ImGuiUpdate);
+            ImGui::SFML::Update(window, sf::seconds(dt));
+        }
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::GameUpdate);
+            game.update(dt);
+        }
 
         // Check if game wants to quit
         if (game.wantsToQuit()) {
@@ -41,11 +118,23 @@ int main() {
         }
 
         window.clear(sf::Color(20, 20, 26)); // dark background
-        game.renderUI();
-        ImGui::SFML::Render(window);
-        window.display();
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::RenderUI);
+            game.renderUI();
+        }
+        prof.drawOverlay();
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::ImGuiRender);
+            ImGui::SFML::Render(window);
+        }
+        {
+            FrameProfiler::Scope scope(&prof, FrameProfiler::Display);
+            window.display();
+        }
+        prof.endFrame();
     }
 
+    log.finish(game.stateHash());
     ImGui::SFML::Shutdown();
     return 0;
 }
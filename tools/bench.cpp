@@ -0,0 +1,549 @@
+// cipher-bench: micro-benchmarks for the core data structures.
+//   cipher-bench lookup [--words PATH] [--length N]
+//   cipher-bench batch  [--words PATH] [--length N]
+//   cipher-bench filter [--words PATH] [--length N]
+//   cipher-bench load   [--words PATH] [--length N]   (0 = every length)
+//   cipher-bench absurdle [--words PATH] [--length N]
+//   cipher-bench alloc  [--words PATH]   (exit 1 if the warm core allocates)
+//   cipher-bench journal [--iterations N]  (N stats records in a temp store)
+//   cipher-bench suggest [--words PATH] [--length N]
+//   cipher-bench nearest [--words PATH] [--length N]
+//   cipher-bench tweens [--iterations N]  (N frames of a 64-board layout)
+#include "AllocCounter.hpp"
+#include "BatchEval.hpp"
+#include "CandidateSet.hpp"
+#include "Dictionary.hpp"
+#include "GameState.hpp"
+#include "StatsJournal.hpp"
+#include "SuggestIndex.hpp"
+#include "Tweens.hpp"
+#include "WordIndex.hpp"
+#include "WordList.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string words = "assets/words.txt";
+        int length = 5;
+        int iterations = 20000000;
+    };
+
+    // Tracks bytes handed out so container footprints can be compared.
+    size_t g_countedBytes = 0;
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+        CountingAllocator() = default;
+        template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+        T* allocate(size_t n) { g_countedBytes += n * sizeof(T); return std::allocator<T>{}.allocate(n); }
+        void deallocate(T* p, size_t n) { g_countedBytes -= n * sizeof(T); std::allocator<T>{}.deallocate(p, n); }
+        template <typename U> bool operator==(const CountingAllocator<U>&) const { return true; }
+    };
+
+    double nsPer(size_t ops, const std::function<void()>& fn) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        return ns / (double)ops;
+    }
+
+    // Half hits, half near-miss words (last letter changed).
+    std::vector<std::string> lookupQueries(const Dictionary& dict, int n) {
+        std::mt19937_64 rng(1234);
+        std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+        std::vector<std::string> q;
+        q.reserve(n);
+        for (int i=0;i<n;++i) {
+            std::string w(dict[pick(rng)]);
+            if (i & 1) w.back() = (char)('A' + (w.back() - 'A' + 1 + (int)(rng() % 25)) % 26);
+            q.push_back(std::move(w));
+        }
+        return q;
+    }
+
+    int benchLookup(const Options& opt) {
+        Dictionary dict = Dictionary::load(opt.words, opt.length);
+        if (dict.empty()) { std::fprintf(stderr, "no words of length %d\n", opt.length); return 1; }
+        const int n = std::min(opt.iterations, 1 << 20);
+        auto queries = lookupQueries(dict, n);
+        std::vector<WordCode> codes;
+        for (const auto& q : queries) codes.push_back(WordCodes::pack(q));
+
+        g_countedBytes = 0;
+        std::unordered_set<std::string, std::hash<std::string>, std::equal_to<std::string>,
+                           CountingAllocator<std::string>> set;
+        for (size_t i=0;i<dict.size();++i) set.emplace(dict[i]);
+        size_t setBytes = g_countedBytes;
+        WordIndex index(dict);
+
+        size_t hits[3] = {0, 0, 0};
+        double tSet = nsPer(n, [&]{ for (const auto& q : queries) hits[0] += set.count(q); });
+        double tSorted = nsPer(n, [&]{ for (const auto& q : queries) hits[1] += dict.contains(q); });
+        double tIndex = nsPer(n, [&]{ for (WordCode c : codes) hits[2] += index.contains(c); });
+
+        std::printf("lookup: %zu words of length %d, %d queries (half misses)\n", dict.size(), opt.length, n);
+        std::printf("  %-28s %8s %12s %8s\n", "structure", "ns/op", "bytes/word", "hits");
+        std::printf("  %-28s %8.1f %12.1f %8zu\n", "unordered_set<std::string>", tSet,
+                    (double)setBytes / dict.size(), hits[0]);
+        std::printf("  %-28s %8.1f %12.1f %8zu\n", "sorted packed letters", tSorted,
+                    (double)opt.length, hits[1]);
+        std::printf("  %-28s %8.1f %12.1f %8zu\n", "WordIndex (eytzinger codes)", tIndex,
+                    (double)index.bytes() / dict.size(), hits[2]);
+        return (hits[0] == hits[1] && hits[1] == hits[2]) ? 0 : 1;
+    }
+
+    // One guess against the whole dictionary: scalar Patterns::score loop
+    // vs every batch kernel the CPU supports; results must match exactly.
+    int benchBatch(const Options& opt) {
+        Dictionary dict = Dictionary::load(opt.words, opt.length);
+        if (dict.empty()) { std::fprintf(stderr, "no words of length %d\n", opt.length); return 1; }
+        const size_t n = dict.size();
+        const size_t guesses = std::max<size_t>(1, std::min<size_t>(n, (size_t)opt.iterations / n));
+        LetterColumns cols(dict);
+
+        std::vector<Pattern> ref(n * guesses), got(n * guesses);
+        double tScalar = nsPer(n * guesses, [&]{
+            for (size_t g=0; g<guesses; ++g) {
+                const char* guess = dict[g * (n / guesses)].data();
+                Pattern* out = ref.data() + g * n;
+                for (size_t a=0; a<n; ++a) out[a] = Patterns::score(dict[a].data(), guess, opt.length);
+            }
+        });
+        std::printf("batch: %zu words of length %d, %zu guesses\n", n, opt.length, guesses);
+        std::printf("  %-10s %8s %8s %10s\n", "kernel", "ns/pair", "speedup", "mismatch");
+        std::printf("  %-10s %8.2f %8.2f %10d\n", "score()", tScalar, 1.0, 0);
+
+        int bad = 0;
+        for (int isa=0; isa<=(int)BatchEval::detect(); ++isa) {
+            BatchEval::force((BatchEval::Isa)isa);
+            double t = nsPer(n * guesses, [&]{
+                for (size_t g=0; g<guesses; ++g)
+                    BatchEval::evaluate(dict[g * (n / guesses)].data(), cols, got.data() + g * n);
+            });
+            size_t mism = 0;
+            for (size_t i=0; i<got.size(); ++i) mism += got[i] != ref[i];
+            bad += mism != 0;
+            std::printf("  %-10s %8.2f %8.2f %10zu\n", BatchEval::name((BatchEval::Isa)isa), t, tScalar / t, mism);
+        }
+        BatchEval::force(BatchEval::detect());
+        return bad ? 1 : 0;
+    }
+
+    // Narrowing cost per submitted guess over random games (6 guesses each).
+    int benchFilter(const Options& opt) {
+        Dictionary dict = Dictionary::load(opt.words, opt.length);
+        if (dict.empty()) { std::fprintf(stderr, "no words of length %d\n", opt.length); return 1; }
+        LetterColumns cols(dict);
+        CandidateSet cands;
+        std::mt19937_64 rng(99);
+        std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+
+        const int games = 200;
+        double total = 0.0, worst = 0.0;
+        int steps = 0, lost = 0;
+        for (int g=0; g<games; ++g) {
+            std::string_view secret = dict[pick(rng)];
+            cands.reset(dict.size());
+            for (int r=0; r<6; ++r) {
+                std::string_view guess = dict[pick(rng)];
+                Pattern p = Patterns::score(secret.data(), guess.data(), opt.length);
+                auto t0 = std::chrono::steady_clock::now();
+                cands.narrow(guess.data(), p, cols);
+                double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+                total += us; worst = std::max(worst, us); ++steps;
+            }
+            long at = dict.find(secret);
+            lost += (at < 0 || !cands.test((size_t)at)); // the secret must always survive
+        }
+        std::printf("filter: %zu words of length %d, %d guesses (%s)\n", dict.size(), opt.length, steps,
+                    BatchEval::name(BatchEval::active()));
+        std::printf("  mean %.1f us/guess, worst %.1f us, secret dropped %d times\n", total / steps, worst, lost);
+        return lost ? 1 : 0;
+    }
+
+    // Parallel mapped word-list load; best of a few runs, the result must
+    // come back sorted and duplicate-free.
+    int benchLoad(const Options& opt) {
+        std::vector<std::string> words;
+        double best = 1e300;
+        for (int run=0; run<3; ++run) {
+            double ns = nsPer(1, [&]{ words = WordList::loadFromFile(opt.words, opt.length); });
+            best = std::min(best, ns);
+        }
+        bool sorted = std::adjacent_find(words.begin(), words.end(),
+                                         [](const std::string& a, const std::string& b) { return a >= b; }) == words.end();
+        std::printf("load: %s, length %d: %zu words in %.1f ms (%.1f M words/s), %s\n", opt.words.c_str(),
+                    opt.length, words.size(), best / 1e6, words.size() / (best / 1e3), sorted ? "sorted" : "NOT SORTED");
+        return sorted ? 0 : 1;
+    }
+
+    // Adversarial partition per guess: score every survivor, counting-sort
+    // into 3^len buckets, keep the largest.
+    int benchAbsurdle(const Options& opt) {
+        Dictionary dict = Dictionary::load(opt.words, opt.length);
+        if (dict.empty()) { std::fprintf(stderr, "no words of length %d\n", opt.length); return 1; }
+        LetterColumns cols(dict);
+        CandidateSet cands;
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+
+        double total = 0.0, first = 0.0, worst = 0.0;
+        int steps = 0, games = 200;
+        size_t left = 0;
+        for (int g=0; g<games; ++g) {
+            cands.reset(dict.size());
+            for (int r=0; r<6 && cands.count() > 1; ++r) {
+                std::string_view guess = dict[pick(rng)];
+                auto t0 = std::chrono::steady_clock::now();
+                cands.keepLargestBucket(guess.data(), cols);
+                double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+                total += us; worst = std::max(worst, us); ++steps;
+                if (r == 0) first += us;
+            }
+            left += cands.count();
+        }
+        std::printf("absurdle: %zu words of length %d, %d guesses (%s)\n", dict.size(), opt.length, steps,
+                    BatchEval::name(BatchEval::active()));
+        std::printf("  mean %.1f us/guess, first guess %.1f us, worst %.1f us, %.1f words left after 6\n",
+                    total / steps, first / games, worst, (double)left / games);
+        return 0;
+    }
+
+    // Plays warm games through GameState and counts heap allocations per
+    // operation: after the first game of each mode nothing should allocate.
+    int benchAlloc(const Options& opt) {
+        struct Mode { const char* name; GameConfig cfg; };
+        GameConfig single, multi, absurd, six;
+        multi.boards = 8; multi.attempts = 10;
+        absurd.adversarial = true;
+        six.length = 6;
+        const Mode modes[] = {{"single", single}, {"boards8", multi}, {"absurdle", absurd}, {"length6", six}};
+
+        GameState g(99);
+        g.setWordsPath(opt.words);
+        std::mt19937_64 rng(5);
+        int failures = 0;
+        std::printf("%-9s %10s %10s %10s %10s\n", "mode", "keypress", "submit", "restart", "newGame");
+        for (const Mode& m : modes) {
+            uint64_t keys = 0, submits = 0, restarts = 0, games = 0;
+            uint64_t nKeys = 0, nSubmits = 0, nRestarts = 0, nGames = 0;
+            auto counted = [](uint64_t& into, auto fn) {
+                uint64_t before = AllocCounter::count();
+                fn();
+                into += AllocCounter::count() - before;
+            };
+            for (int round=0; round<40; ++round) {
+                const bool warm = round > 0;
+                uint64_t scratch = 0;
+                counted(warm ? games : scratch, [&]{ g.newGame(m.cfg); });
+                nGames += warm;
+                if (round % 4 == 3) {
+                    counted(warm ? restarts : scratch, [&]{ g.restart(); });
+                    nRestarts += warm;
+                }
+                const Dictionary& dict = g.dictionary();
+                std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+                while (!g.finished()) {
+                    std::string_view w = dict[pick(rng)];
+                    counted(warm ? keys : scratch, [&]{
+                        size_t idx[8];
+                        g.typeLetter('Q'); g.backspace();
+                        for (char c : w) { g.typeLetter(c); g.suggestions(idx, 8); }
+                        g.nearest(w, idx, 3); // "did you mean" after a rejected guess
+                    });
+                    nKeys += warm ? w.size() + 2 : 0;
+                    counted(warm ? submits : scratch, [&]{ g.submit(); });
+                    nSubmits += warm;
+                }
+            }
+            std::printf("%-9s %10.3f %10.3f %10.3f %10.3f\n", m.name, (double)keys / nKeys,
+                        (double)submits / nSubmits, (double)restarts / nRestarts, (double)games / nGames);
+            failures += keys || submits || restarts || games;
+        }
+        std::printf("(heap allocations per call after the first game of each mode)\n");
+        if (failures) std::printf("FAIL: %d mode(s) allocate\n", failures);
+        return failures ? 1 : 0;
+    }
+
+    // Appends N records, then times opening the store with no snapshot, a
+    // compaction, and opening again from the snapshot plus a short tail.
+    int benchJournal(const Options& opt) {
+        namespace fs = std::filesystem;
+        const std::string base = (fs::temp_directory_path() / "cipher-bench-stats").string();
+        auto cleanup = [&] {
+            std::error_code ec;
+            fs::remove(base + ".journal", ec);
+            fs::remove(base + ".snap", ec);
+        };
+        cleanup();
+        const uint64_t n = (uint64_t)std::max(1, opt.iterations);
+        std::mt19937_64 rng(11);
+        StatsJournal::Record rec{};
+        rec.length = 5; rec.boards = 1;
+        auto next = [&] {
+            uint64_t x = rng();
+            rec.time = 1700000000 + (int64_t)(x & 0xFFFFF);
+            rec.secret = (uint32_t)(x >> 20) % 13000;
+            rec.attempts = (uint8_t)(1 + (x >> 40) % 6);
+            rec.flags = (uint8_t)(((x >> 48) % 10 ? StatsJournal::kWin : 0) | (StatsJournal::Bot << 4));
+            return rec;
+        };
+
+        auto since = [](std::chrono::steady_clock::time_point t0) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+        StatsJournal j;
+        if (!j.open(base)) { std::fprintf(stderr, "cannot open %s.journal\n", base.c_str()); return 1; }
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint64_t i=0; i<n; ++i) j.append(next());
+        j.flush();
+        double tAppend = since(t0);
+        Stats expect = j.stats(StatsJournal::Bot);
+        j.close();
+
+        t0 = std::chrono::steady_clock::now();
+        j.open(base);
+        double tCold = since(t0);
+        bool ok = j.stats(StatsJournal::Bot).total == expect.total &&
+                  j.stats(StatsJournal::Bot).maxStreak == expect.maxStreak &&
+                  j.stats(StatsJournal::Bot).distribution == expect.distribution;
+
+        t0 = std::chrono::steady_clock::now();
+        j.compact();
+        double tCompact = since(t0);
+        for (int i=0; i<1000; ++i) j.append(next());
+        expect = j.stats(StatsJournal::Bot);
+        j.close();
+
+        t0 = std::chrono::steady_clock::now();
+        j.open(base);
+        double tWarm = since(t0);
+        ok = ok && j.stats(StatsJournal::Bot).currentStreak == expect.currentStreak &&
+             j.stats(StatsJournal::Bot).maxStreak == expect.maxStreak &&
+             j.stats(StatsJournal::Bot).distribution == expect.distribution;
+        uint64_t tail = j.tail();
+        j.close();
+        cleanup();
+
+        std::printf("journal: %llu records (%.1f MB)\n", (unsigned long long)n,
+                    n * sizeof(StatsJournal::Record) / 1048576.0);
+        std::printf("  append %.1f ns/record, open with no snapshot %.1f ms, compact %.1f ms,\n"
+                    "  open from snapshot + %llu-record tail %.3f ms, stats %s\n",
+                    tAppend * 1e6 / n, tCold, tCompact, (unsigned long long)tail, tWarm, ok ? "match" : "MISMATCH");
+        return ok ? 0 : 1;
+    }
+
+    // Suggestion queries as the player types: the feedback of 0-3 random
+    // guesses plus a prefix of the secret. Reports index size and query
+    // latency; the first few hundred are checked against a full scan.
+    int benchSuggest(const Options& opt) {
+        Dictionary dict = Dictionary::load(opt.words, opt.length);
+        if (dict.empty()) { std::fprintf(stderr, "no words of length %d\n", opt.length); return 1; }
+        const int len = dict.length();
+        auto t0 = std::chrono::steady_clock::now();
+        SuggestIndex index(dict);
+        double tBuild = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        std::mt19937_64 rng(21);
+        std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+        const int queries = 5000, checked = 200;
+        std::vector<double> us;
+        us.reserve(queries);
+        double scanUs = 0.0;
+        size_t matched = 0;
+        int bad = 0;
+        for (int q=0; q<queries; ++q) {
+            std::string_view secret = dict[pick(rng)];
+            SuggestIndex::Query query;
+            for (int g=(int)(rng() % 4); g>0; --g) {
+                std::string_view guess = dict[pick(rng)];
+                TileState st[Patterns::kMaxLength];
+                Patterns::decode(Patterns::score(secret.data(), guess.data(), len), len, st);
+                query.addFeedback(guess.data(), st, len);
+            }
+            query.setPrefix(secret.substr(0, rng() % (size_t)len));
+
+            size_t idx[8];
+            t0 = std::chrono::steady_clock::now();
+            size_t total = index.query(query, idx, 8);
+            us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+            matched += total;
+            if (q < checked) {
+                t0 = std::chrono::steady_clock::now();
+                size_t expect = 0;
+                for (size_t i=0; i<dict.size(); ++i) expect += query.matches(dict[i]);
+                scanUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+                bad += expect != total;
+            }
+            bad += total == 0; // the secret always fits
+        }
+        std::sort(us.begin(), us.end());
+        std::printf("suggest: %zu words of length %d, index %.2f MB (%.1f bytes/word), built in %.1f ms\n",
+                    dict.size(), len, index.bytes() / 1048576.0, (double)index.bytes() / dict.size(), tBuild);
+        std::printf("  %d queries: p50 %.1f us, p99 %.1f us, max %.1f us, %.0f matches on average\n", queries,
+                    us[us.size() / 2], us[us.size() * 99 / 100], us.back(), (double)matched / queries);
+        std::printf("  full scan %.1f us/query over the first %d; %s\n", scanUs / checked, checked,
+                    bad ? "MISMATCH" : "results match");
+        return bad ? 1 : 0;
+    }
+
+    // "Did you mean" lookups for one- and two-letter typos of random words,
+    // through GameState::nearest(). Reports latency; the first few hundred
+    // are checked against a scalar Hamming scan.
+    int benchNearest(const Options& opt) {
+        GameState g(3);
+        g.setWordsPath(opt.words);
+        GameConfig cfg;
+        cfg.length = opt.length;
+        g.newGame(cfg);
+        const Dictionary& dict = g.dictionary();
+        if (dict.empty() || dict.length() != opt.length) {
+            std::fprintf(stderr, "no words of length %d\n", opt.length);
+            return 1;
+        }
+        const int len = dict.length();
+
+        std::mt19937_64 rng(23);
+        std::uniform_int_distribution<size_t> pick(0, dict.size() - 1);
+        const int queries = 2000, checked = 200;
+        std::vector<double> us;
+        us.reserve(queries);
+        size_t returned = 0;
+        int bad = 0;
+        std::string typo(len, 'A');
+        for (int q=0; q<queries; ++q) {
+            std::string_view w = dict[pick(rng)];
+            typo.assign(w);
+            for (int e=1 + (int)(rng() % 2); e>0; --e) typo[rng() % len] = (char)('A' + rng() % 26);
+
+            size_t idx[3];
+            auto t0 = std::chrono::steady_clock::now();
+            size_t found = g.nearest(typo, idx, 3);
+            us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+            returned += found;
+            if (q < checked) {
+                auto dist = [&](std::string_view a) {
+                    int d = 0;
+                    for (int p=0; p<len; ++p) d += a[p] != typo[p];
+                    return d;
+                };
+                size_t within = 0;
+                int best = len + 1;
+                for (size_t i=0; i<dict.size(); ++i) {
+                    int d = dist(dict[i]);
+                    within += d <= 2;
+                    best = std::min(best, d);
+                }
+                bad += found != std::min<size_t>(within, 3);
+                for (size_t i=0; i<found; ++i) bad += dist(dict[idx[i]]) > 2 || (i && dist(dict[idx[i]]) < dist(dict[idx[i-1]]));
+                bad += found && dist(dict[idx[0]]) != best;
+            }
+            bad += found == 0; // the source word is at most two letters away
+        }
+        std::sort(us.begin(), us.end());
+        std::printf("nearest: %zu words of length %d, %s kernel\n", dict.size(), len,
+                    BatchEval::name(BatchEval::active()));
+        std::printf("  %d queries: p50 %.1f us, p99 %.1f us, max %.1f us, %.1f results on average; %s\n", queries,
+                    us[us.size() / 2], us[us.size() * 99 / 100], us.back(), (double)returned / queries,
+                    bad ? "MISMATCH" : "results match");
+        return bad ? 1 : 0;
+    }
+
+    // Frame update cost of the UI animations on 64 boards of 10 x 6 tiles:
+    // a full sweep over every key and tile each frame (what Game::update
+    // used to do) against the Tweens active set. A row is submitted every
+    // 40 frames; both must end with identical values.
+    int benchTweens(const Options& opt) {
+        const int boards = 64, rows = 10, len = 6, every = 40;
+        const int frames = std::max(every, std::min(opt.iterations, 200000));
+        const float dt = 1.f / 60.f, flipSpeed = 6.f, keyFade = 0.6f;
+        const size_t tiles = (size_t)boards * rows * len;
+        std::vector<float> flipScan(tiles, 1.f), flipLive(tiles, 1.f);
+        std::vector<float> keyScan(boards * 26, 0.f), keyLive(boards * 26, 0.f);
+        std::vector<float> keyTo(boards * 26, 0.f), keyFrom(boards * 26, 0.f), keyT(boards * 26, 1.f);
+        Tweens live;
+        std::mt19937_64 rng(24);
+        double tScan = 0.0, tLive = 0.0;
+        size_t peak = 0;
+        uint64_t allocs = 0;
+        for (int f=0; f<frames; ++f) {
+            if (f % every == 0) {
+                const int row = (f / every) % rows;
+                for (int b=0; b<boards; ++b) {
+                    for (int c=0; c<len; ++c) {
+                        size_t i = ((size_t)b * rows + row) * len + c;
+                        flipScan[i] = flipLive[i] = 0.f;
+                        live.start(&flipLive[i], 1.f, 1.f / flipSpeed);
+                        int k = b * 26 + (int)(rng() % 26);
+                        float to = (float)(rng() % 3) * 0.5f;
+                        if (keyLive[k] == to) continue;
+                        keyFrom[k] = keyScan[k]; keyTo[k] = to; keyT[k] = 0.f;
+                        live.retarget(&keyLive[k], to, keyFade, Ease::OutCubic);
+                    }
+                }
+            }
+            auto t0 = std::chrono::steady_clock::now();
+            const float step = dt * flipSpeed;
+            for (float& v : flipScan) v = std::min(1.f, v + step);
+            for (size_t k=0; k<keyScan.size(); ++k) {
+                if (keyT[k] >= 1.f) continue;
+                keyT[k] = std::min(1.f, keyT[k] + dt / keyFade);
+                keyScan[k] = keyT[k] >= 1.f ? keyTo[k] : keyFrom[k] + (keyTo[k] - keyFrom[k]) * ease(Ease::OutCubic, keyT[k]);
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            uint64_t before = AllocCounter::count();
+            live.update(dt);
+            auto t2 = std::chrono::steady_clock::now();
+            if (f >= every) allocs += AllocCounter::count() - before;
+            tScan += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            tLive += std::chrono::duration<double, std::micro>(t2 - t1).count();
+            peak = std::max(peak, live.size());
+        }
+        int bad = 0;
+        for (size_t i=0; i<tiles; ++i) bad += std::fabs(flipScan[i] - flipLive[i]) > 1e-4f;
+        for (size_t k=0; k<keyScan.size(); ++k) bad += std::fabs(keyScan[k] - keyLive[k]) > 1e-4f;
+        std::printf("tweens: %d boards x %d x %d tiles, %d frames, peak %zu active\n", boards, rows, len, frames, peak);
+        std::printf("  full scan %.2f us/frame, active set %.2f us/frame, %llu allocations after warm-up; %s\n",
+                    tScan / frames, tLive / frames, (unsigned long long)allocs, bad ? "MISMATCH" : "values match");
+        return bad || allocs ? 1 : 0;
+    }
+
+    void usage() {
+        std::fprintf(stderr, "usage: cipher-bench <lookup|batch|filter|load|absurdle|alloc|journal|suggest|nearest|tweens> [--words PATH] [--length N] [--iterations N]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 2; }
+    std::string cmd = argv[1];
+    Options opt;
+    for (int i=2;i<argc;++i) {
+        std::string a = argv[i];
+        if (a == "--words" && i+1 < argc) opt.words = argv[++i];
+        else if (a == "--length" && i+1 < argc) opt.length = std::atoi(argv[++i]);
+        else if (a == "--iterations" && i+1 < argc) opt.iterations = std::atoi(argv[++i]);
+        else { usage(); return 2; }
+    }
+    if (cmd == "lookup") return benchLookup(opt);
+    if (cmd == "batch") return benchBatch(opt);
+    if (cmd == "filter") return benchFilter(opt);
+    if (cmd == "load") return benchLoad(opt);
+    if (cmd == "absurdle") return benchAbsurdle(opt);
+    if (cmd == "alloc") return benchAlloc(opt);
+    if (cmd == "journal") return benchJournal(opt);
+    if (cmd == "suggest") return benchSuggest(opt);
+    if (cmd == "nearest") return benchNearest(opt);
+    if (cmd == "tweens") return benchTweens(opt);
+    usage();
+    return 2;
+}
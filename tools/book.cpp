@@ -0,0 +1,80 @@
+// cipher-book: builds the hint book (precomputed strategy tree) for every
+// word length and saves it next to the word list. A book that still matches
+// the list is kept; one for an older list seeds the rebuild, so only the
+// subtrees whose candidates changed are solved again.
+#include "HintBook.hpp"
+#include "PatternMatrix.hpp"
+#include "Solver.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-book [--words PATH] [--length N] [--depth 1|2] [--top K]\n"
+            "                   [--threads N] [--rebuild]\n");
+    }
+
+    double since(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string wordsPath = "assets/words.txt";
+    int onlyLen = 0, threads = 0;
+    bool rebuild = false;
+    Solver::Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--words") wordsPath = next();
+        else if (a == "--length") onlyLen = std::atoi(next());
+        else if (a == "--depth") opt.depth = std::atoi(next());
+        else if (a == "--top") opt.topK = std::atoi(next());
+        else if (a == "--threads") threads = std::atoi(next());
+        else if (a == "--rebuild") rebuild = true;
+        else { usage(); return 2; }
+    }
+
+    ThreadPool pool(threads);
+    int failures = 0;
+    for (int len=4; len<=6; ++len) {
+        if (onlyLen && len != onlyLen) continue;
+        Dictionary words = Dictionary::load(wordsPath, len);
+        if (words.empty()) { std::printf("len %d: no words\n", len); continue; }
+        const std::string path = HintBook::bookPath(wordsPath, len);
+
+        HintBook previous;
+        bool havePrevious = !rebuild && previous.open(path);
+        if (havePrevious && previous.matches(words)) {
+            std::printf("len %d: %zu words, %zu nodes, up to date -> %s\n", len, words.size(), previous.nodes(),
+                        path.c_str());
+            continue;
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        PatternMatrix m = PatternMatrix::loadOrBuild(wordsPath, words, threads);
+        Solver solver(words, m, pool);
+        HintBook book;
+        HintBook::BuildStats st = book.build(words, solver, pool, opt, havePrevious ? &previous : nullptr);
+        double secs = since(t0);
+
+        uint64_t total = 0; int worst = 0;
+        book.cost(total, worst);
+        std::printf("len %d: %zu words, %zu nodes (%zu reused) in %.3f s, avg %.3f guesses, worst %d -> %s\n",
+            len, words.size(), st.nodes, st.reused, secs, (double)total / words.size(), worst, path.c_str());
+        previous = HintBook{}; // unmap before the file is replaced
+        if (!book.save(path)) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            ++failures;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,41 @@
+// cipher-dictc: compiles a text word list into the packed binary format
+// read by DictionaryFile (one sorted section per word length).
+#include "Dictionary.hpp"
+#include "WordList.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::string in, out;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        if ((a == "-o" || a == "--output") && i+1 < argc) out = argv[++i];
+        else if (in.empty() && !a.empty() && a[0] != '-') in = a;
+        else {
+            std::fprintf(stderr, "usage: cipher-dictc <words.txt> [-o words.bin]\n");
+            return 2;
+        }
+    }
+    if (in.empty()) {
+        std::fprintf(stderr, "usage: cipher-dictc <words.txt> [-o words.bin]\n");
+        return 2;
+    }
+    if (out.empty()) out = std::filesystem::path(in).replace_extension(".bin").string();
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto words = WordList::loadFromFile(in, 0);
+    if (words.empty()) { std::fprintf(stderr, "no words in %s\n", in.c_str()); return 1; }
+    if (!DictionaryFile::write(out, words)) { std::fprintf(stderr, "cannot write %s\n", out.c_str()); return 1; }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    DictionaryFile f;
+    if (!f.open(out)) { std::fprintf(stderr, "wrote %s but cannot read it back\n", out.c_str()); return 1; }
+    std::printf("%s -> %s in %.1f ms\n", in.c_str(), out.c_str(), ms);
+    for (int len=1; len<=32; ++len) {
+        Dictionary d = f.section(len);
+        if (!d.empty()) std::printf("  len %2d: %zu words\n", len, d.size());
+    }
+    return 0;
+}
@@ -0,0 +1,229 @@
+// cipher-headless: plays games through GameState without a window.
+//
+// Reads commands from a script file (or stdin) one per line:
+//   WORD               type + submit a guess (starts a new game if the last one ended)
+//   :new [daily]       start a new random (or daily) game
+//   :restart           restart the current game with the same secret
+//   :length N          set word length and start a new game
+//   :attempts N        set attempts and start a new game
+//   :boards N          set the number of simultaneous boards and start a new game
+//   :absurdle on|off   adversarial mode (no fixed secret) and start a new game
+//   :strict on|off     toggle the strict dictionary check
+//   :hint              the hint book's next guess (- when off the book or no book)
+//   :suggest [PREFIX]  words that fit the board so far (and start with PREFIX)
+//   # ...              comment
+#include "GameState.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string script;          // empty = stdin
+        std::string words = "assets/words.txt";
+        uint64_t seed = 0;
+        bool seeded = false;
+        int repeat = 1;              // replay the script N times
+        bool quiet = false;
+        GameConfig cfg{};
+    };
+
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-headless [--words PATH] [--seed N] [--length N] [--attempts N]\n"
+            "                       [--boards N] [--absurdle] [--daily] [--repeat N] [--quiet] [script]\n");
+    }
+
+    // whole-string decimal int; false (out untouched) for anything else
+    bool parseInt(const char* s, int& out) {
+        char* end = nullptr;
+        errno = 0;
+        long v = std::strtol(s, &end, 10);
+        if (end == s || *end != '\0' || errno == ERANGE || v < INT_MIN || v > INT_MAX) return false;
+        out = (int)v;
+        return true;
+    }
+
+    char tileChar(TileState t) {
+        return t == TileState::Correct ? 'G' : (t == TileState::Present ? 'Y' : '.');
+    }
+
+    // one pattern per board; boards solved on an earlier row print blank
+    void printRow(const GameState& g, int r) {
+        const std::string& w = g.row(r);
+        std::string pat;
+        size_t left = 0;
+        for (int b=0;b<g.boards();++b) {
+            const TileState* st = g.rowStates(r, b);
+            bool done = g.solvedAt(b) >= 0 && g.solvedAt(b) < r;
+            for (size_t i=0;i<w.size();++i) pat.push_back(done ? ' ' : tileChar(st[i]));
+            pat.push_back(' ');
+            left += done ? 0 : g.candidates(b).count();
+        }
+        pat.pop_back();
+        std::printf("%s %s  (%zu left)\n", w.c_str(), pat.c_str(), left);
+    }
+
+    void run(GameState& g, const std::vector<std::string>& lines, const Options& opt) {
+        GameConfig cfg = g.config();
+        for (const std::string& raw : lines) {
+            std::istringstream ls(raw);
+            std::string cmd;
+            if (!(ls >> cmd) || cmd[0] == '#') continue;
+
+            if (cmd[0] == ':') {
+                std::string arg; ls >> arg;
+                if (cmd == ":new") {
+                    cfg.daily = (arg == "daily");
+                    g.newGame(cfg);
+                } else if (cmd == ":restart") {
+                    g.restart();
+                } else if (cmd == ":length") {
+                    if (!parseInt(arg.c_str(), cfg.length)) {
+                        if (!opt.quiet) std::printf("? bad length %s\n", arg.c_str());
+                        continue;
+                    }
+                    g.newGame(cfg);
+                } else if (cmd == ":attempts") {
+                    if (!parseInt(arg.c_str(), cfg.attempts)) {
+                        if (!opt.quiet) std::printf("? bad attempts %s\n", arg.c_str());
+                        continue;
+                    }
+                    g.newGame(cfg);
+                } else if (cmd == ":boards") {
+                    if (!parseInt(arg.c_str(), cfg.boards)) {
+                        if (!opt.quiet) std::printf("? bad boards %s\n", arg.c_str());
+                        continue;
+                    }
+                    g.newGame(cfg);
+                } else if (cmd == ":absurdle") {
+                    cfg.adversarial = (arg == "on");
+                    g.newGame(cfg);
+                } else if (cmd == ":hint") {
+                    std::string_view h = g.bookHint();
+                    if (h.empty()) h = "-";
+                    if (!opt.quiet) std::printf("hint %.*s\n", (int)h.size(), h.data());
+                } else if (cmd == ":suggest") {
+                    if (g.finished()) g.newGame(cfg);
+                    for (char c : arg) g.typeLetter(c);
+                    size_t idx[8];
+                    size_t total = g.suggestions(idx, 8);
+                    while (g.backspace()) {}
+                    if (opt.quiet) continue;
+                    std::printf("suggest %zu:", total);
+                    for (size_t i=0; i<std::min<size_t>(total, 8); ++i) {
+                        std::string_view w = g.dictionary()[idx[i]];
+                        std::printf(" %.*s", (int)w.size(), w.data());
+                    }
+                    std::printf("%s\n", total > 8 ? " ..." : "");
+                } else if (cmd == ":strict") {
+                    g.setLenient(arg != "on");
+                } else if (!opt.quiet) {
+                    std::printf("? unknown command %s\n", cmd.c_str());
+                }
+                continue;
+            }
+
+            if (g.finished()) g.newGame(cfg);
+            if (cmd.size() > (size_t)g.config().length) {
+                // typeLetter() would drop the extra letters and play the prefix
+                if (!opt.quiet) std::printf("! too many letters\n");
+                continue;
+            }
+            for (char c : cmd) g.typeLetter(c);
+            int row = g.rowIndex();
+            SubmitResult res = g.submit();
+            if (opt.quiet) continue;
+            switch (res) {
+            case SubmitResult::Accepted:
+                printRow(g, row);
+                if (g.won()) std::printf("= win %d/%d\n", row + 1, g.rows());
+                else if (g.outOfAttempts()) {
+                    std::printf("= loss, the word%s", g.boards() > 1 ? "s were" : " was");
+                    for (int b=0;b<g.boards();++b) {
+                        std::string_view s = g.secret(b);
+                        std::printf(" %.*s", (int)s.size(), s.data());
+                    }
+                    std::printf("\n");
+                }
+                break;
+            case SubmitResult::TooShort:
+                std::printf("! not enough letters\n");
+                while (g.backspace()) {}
+                break;
+            case SubmitResult::NotInList:
+                std::printf("! word not in list\n");
+                while (g.backspace()) {}
+                break;
+            case SubmitResult::Finished:
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--words") opt.words = next();
+        else if (a == "--seed") { opt.seed = std::strtoull(next(), nullptr, 10); opt.seeded = true; }
+        else if (a == "--length") {
+            if (!parseInt(next(), opt.cfg.length)) { usage(); return 2; }
+        }
+        else if (a == "--attempts") {
+            if (!parseInt(next(), opt.cfg.attempts)) { usage(); return 2; }
+        }
+        else if (a == "--boards") {
+            if (!parseInt(next(), opt.cfg.boards)) { usage(); return 2; }
+        }
+        else if (a == "--absurdle") opt.cfg.adversarial = true;
+        else if (a == "--daily") opt.cfg.daily = true;
+        else if (a == "--repeat") {
+            if (!parseInt(next(), opt.repeat)) { usage(); return 2; }
+        }
+        else if (a == "--quiet") opt.quiet = true;
+        else if (a == "-h" || a == "--help") { usage(); return 0; }
+        else if (!a.empty() && a[0] == '-') { usage(); return 2; }
+        else opt.script = a;
+    }
+
+    std::vector<std::string> lines;
+    {
+        std::ifstream file;
+        if (!opt.script.empty()) {
+            file.open(opt.script);
+            if (!file) { std::fprintf(stderr, "cannot open %s\n", opt.script.c_str()); return 1; }
+        }
+        std::istream& in = opt.script.empty() ? std::cin : file;
+        std::string line;
+        while (std::getline(in, line)) lines.push_back(line);
+    }
+
+    GameState g = opt.seeded ? GameState(opt.seed) : GameState();
+    g.setWordsPath(opt.words);
+    g.newGame(opt.cfg);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r=0;r<opt.repeat;++r) run(g, lines, opt);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const Stats& s = g.stats();
+    std::printf("played %d, wins %d, streak %d/%d\n", s.total, s.wins, s.currentStreak, s.maxStreak);
+    std::printf("distribution:");
+    for (int i=0;i<g.config().attempts && i<(int)s.distribution.size();++i) std::printf(" %d", s.distribution[i]);
+    std::printf("\n%.3f s, %.0f games/s\n", secs, secs > 0 ? s.total / secs : 0.0);
+    return 0;
+}
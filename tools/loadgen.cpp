@@ -0,0 +1,244 @@
+// cipher-load: closed-loop load generator for cipher-server. Each client
+// keeps one request in flight, playing random dictionary words until its
+// game ends and then starting the next one (optionally on a new
+// connection). Prints throughput and request latency percentiles.
+#include "Dictionary.hpp"
+#include "GameState.hpp"
+#include "Protocol.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        std::string host = "127.0.0.1";
+        int port = Protocol::kDefaultPort;
+        std::string unixPath;
+        int clients = 64;
+        int threads = 1;
+        double seconds = 5.0;
+        std::string wordsPath = "assets/words.txt";
+        int length = 5;
+        bool reconnect = false;
+    };
+
+    struct Client {
+        int fd = -1;
+        std::vector<uint8_t> in;
+        Clock::time_point sentAt;
+    };
+
+    struct Totals {
+        std::vector<uint32_t> latencyNs;
+        uint64_t requests = 0, games = 0, wins = 0, connects = 0, errors = 0;
+    };
+
+    int connectTo(const Options& opt) {
+        int fd;
+        if (!opt.unixPath.empty()) {
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            std::strncpy(addr.sun_path, opt.unixPath.c_str(), sizeof(addr.sun_path) - 1);
+            fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) { if (fd >= 0) ::close(fd); return -1; }
+        } else {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons((uint16_t)opt.port);
+            if (::inet_pton(AF_INET, opt.host.c_str(), &addr.sin_addr) != 1) return -1;
+            fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0 || ::connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) { if (fd >= 0) ::close(fd); return -1; }
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        // connect blocking (loopback is immediate), then run non-blocking
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        return fd;
+    }
+
+    // Runs `count` clients on one epoll until `deadline`.
+    void runClients(const Options& opt, const Dictionary& dict, int count, uint64_t seed,
+                    Clock::time_point deadline, Totals& t) {
+        std::mt19937_64 rng(seed);
+        std::vector<Client> clients((size_t)count);
+        int ep = ::epoll_create1(EPOLL_CLOEXEC);
+        uint8_t msg[Protocol::kMaxMessage];
+        const size_t newGame = Protocol::Writer(msg, Protocol::NewGame)
+            .u8((uint8_t)opt.length).u8(6).u8(1).u8(0).finish();
+        uint8_t newGameMsg[Protocol::kMaxMessage];
+        std::memcpy(newGameMsg, msg, newGame);
+
+        auto send = [&](Client& c, const uint8_t* p, size_t n) {
+            c.sentAt = Clock::now();
+            return ::send(c.fd, p, n, MSG_NOSIGNAL) == (ssize_t)n; // one small request at a time
+        };
+        auto sendGuess = [&](Client& c) {
+            std::string_view w = dict[std::uniform_int_distribution<size_t>(0, dict.size() - 1)(rng)];
+            size_t n = Protocol::Writer(msg, Protocol::Guess).bytes(w.data(), w.size()).finish();
+            return send(c, msg, n);
+        };
+        auto open = [&](Client& c) {
+            c.fd = connectTo(opt);
+            if (c.fd < 0) return false;
+            c.in.clear();
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = &c;
+            ::epoll_ctl(ep, EPOLL_CTL_ADD, c.fd, &ev);
+            ++t.connects;
+            return send(c, newGameMsg, newGame);
+        };
+        auto drop = [&](Client& c) {
+            ::epoll_ctl(ep, EPOLL_CTL_DEL, c.fd, nullptr);
+            ::close(c.fd);
+            c.fd = -1;
+        };
+
+        for (Client& c : clients) if (!open(c)) ++t.errors;
+
+        epoll_event events[256];
+        uint8_t buf[4096];
+        while (Clock::now() < deadline) {
+            int n = ::epoll_wait(ep, events, 256, 50);
+            if (n < 0 && errno != EINTR) break;
+            for (int i=0; i<n; ++i) {
+                Client& c = *(Client*)events[i].data.ptr;
+                ssize_t got = ::recv(c.fd, buf, sizeof(buf), 0);
+                if (got <= 0) {
+                    if (got < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                    ++t.errors;
+                    drop(c);
+                    if (!open(c)) ++t.errors;
+                    continue;
+                }
+                c.in.insert(c.in.end(), buf, buf + got);
+                size_t len = Protocol::complete(c.in.data(), c.in.size());
+                if (len == 0) continue;
+
+                auto now = Clock::now();
+                t.latencyNs.push_back((uint32_t)std::min<int64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now - c.sentAt).count(), UINT32_MAX));
+                ++t.requests;
+
+                const uint8_t op = c.in[0];
+                Protocol::Reader r(c.in.data() + Protocol::kHeader, len - Protocol::kHeader);
+                bool finished = false, ok = true;
+                if (op == Protocol::Guess) {
+                    r.u8(); // SubmitResult; rejected words just lose the turn
+                    uint8_t status = r.u8();
+                    if (status != Protocol::Playing) {
+                        finished = true;
+                        ++t.games;
+                        if (status == Protocol::Won) ++t.wins;
+                    }
+                } else if (op != Protocol::NewGame) {
+                    ok = false;
+                }
+                c.in.erase(c.in.begin(), c.in.begin() + (ptrdiff_t)len);
+
+                if (!ok) { ++t.errors; drop(c); if (!open(c)) ++t.errors; continue; }
+                if (finished && opt.reconnect) { drop(c); if (!open(c)) ++t.errors; continue; }
+                bool sent = finished ? send(c, newGameMsg, newGame) : sendGuess(c);
+                if (!sent) { ++t.errors; drop(c); if (!open(c)) ++t.errors; }
+            }
+        }
+        for (Client& c : clients) if (c.fd >= 0) ::close(c.fd);
+        ::close(ep);
+    }
+
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-load [--host ADDR] [--port N] [--unix PATH] [--clients N] [--threads N]\n"
+            "                   [--seconds S] [--words PATH] [--length N] [--reconnect]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--host") opt.host = next();
+        else if (a == "--port") opt.port = std::atoi(next());
+        else if (a == "--unix") opt.unixPath = next();
+        else if (a == "--clients") opt.clients = std::max(1, std::atoi(next()));
+        else if (a == "--threads") opt.threads = std::max(1, std::atoi(next()));
+        else if (a == "--seconds") opt.seconds = std::atof(next());
+        else if (a == "--words") opt.wordsPath = next();
+        else if (a == "--length") opt.length = std::atoi(next());
+        else if (a == "--reconnect") opt.reconnect = true;
+        else { usage(); return 2; }
+    }
+    opt.threads = std::min(opt.threads, opt.clients);
+
+    // same word list as the server so most guesses are accepted
+    GameState words;
+    words.setWordsPath(opt.wordsPath);
+    GameConfig cfg;
+    cfg.length = opt.length;
+    words.newGame(cfg);
+    const Dictionary& dict = words.dictionary();
+    if (dict.empty()) { std::fprintf(stderr, "cipher-load: no %d-letter words in %s\n", opt.length, opt.wordsPath.c_str()); return 1; }
+    opt.length = dict.length();
+
+    int probe = connectTo(opt);
+    if (probe < 0) { std::fprintf(stderr, "cipher-load: cannot connect: %s\n", std::strerror(errno)); return 1; }
+    ::close(probe);
+
+    std::vector<Totals> totals((size_t)opt.threads);
+    std::vector<std::thread> threads;
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(opt.seconds));
+    for (int t=0; t<opt.threads; ++t) {
+        int count = opt.clients / opt.threads + (t < opt.clients % opt.threads ? 1 : 0);
+        totals[(size_t)t].latencyNs.reserve(1 << 20);
+        threads.emplace_back(runClients, std::cref(opt), std::cref(dict), count, 0x5EEDull + (uint64_t)t,
+                             deadline, std::ref(totals[(size_t)t]));
+    }
+    for (auto& th : threads) th.join();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Totals all;
+    for (Totals& t : totals) {
+        all.latencyNs.insert(all.latencyNs.end(), t.latencyNs.begin(), t.latencyNs.end());
+        all.requests += t.requests; all.games += t.games; all.wins += t.wins;
+        all.connects += t.connects; all.errors += t.errors;
+    }
+    std::sort(all.latencyNs.begin(), all.latencyNs.end());
+    auto pct = [&](double p) {
+        if (all.latencyNs.empty()) return 0.0;
+        size_t i = std::min(all.latencyNs.size() - 1, (size_t)(p * (double)all.latencyNs.size()));
+        return all.latencyNs[i] / 1000.0;
+    };
+
+    std::printf("%d clients on %d thread%s for %.2f s against %s\n", opt.clients, opt.threads,
+        opt.threads == 1 ? "" : "s", secs,
+        opt.unixPath.empty() ? (opt.host + ":" + std::to_string(opt.port)).c_str() : opt.unixPath.c_str());
+    std::printf("requests %llu (%.0f/s), games %llu (%.0f/s, %llu won), connections %llu, errors %llu\n",
+        (unsigned long long)all.requests, all.requests / secs, (unsigned long long)all.games, all.games / secs,
+        (unsigned long long)all.wins, (unsigned long long)all.connects, (unsigned long long)all.errors);
+    std::printf("latency us: p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+        pct(0.50), pct(0.90), pct(0.99), pct(0.999), all.latencyNs.empty() ? 0.0 : all.latencyNs.back() / 1000.0);
+    return all.errors ? 1 : 0;
+}
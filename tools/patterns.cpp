@@ -0,0 +1,74 @@
+// cipher-patterns: builds (or maps) the guess x answer pattern cache for
+// every supported word length and reports how long it took.
+#include "PatternMatrix.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+namespace {
+    // Independent reference for --verify: the textbook two-pass scorer
+    // (greens first, then yellows from the leftover letter counts), building
+    // the base-3 code itself so it shares nothing with Patterns::score.
+    Pattern referenceScore(std::string_view secret, std::string_view guess) {
+        const size_t len = guess.size();
+        int left[26] = {0};
+        bool green[Patterns::kMaxLength] = {};
+        for (size_t i=0; i<len; ++i) {
+            green[i] = guess[i] == secret[i];
+            if (!green[i]) ++left[secret[i] - 'A'];
+        }
+        unsigned code = 0, weight = 1;
+        for (size_t i=0; i<len; ++i, weight *= 3) {
+            if (green[i]) code += 2 * weight;
+            else if (left[guess[i] - 'A'] > 0) { --left[guess[i] - 'A']; code += weight; }
+        }
+        return (Pattern)code;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string wordsPath = "assets/words.txt";
+    int threads = 0;
+    bool rebuild = false, verify = false;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        if (a == "--words" && i+1 < argc) wordsPath = argv[++i];
+        else if (a == "--threads" && i+1 < argc) threads = std::atoi(argv[++i]);
+        else if (a == "--rebuild") rebuild = true;
+        else if (a == "--verify") verify = true;
+        else {
+            std::fprintf(stderr, "usage: cipher-patterns [--words PATH] [--threads N] [--rebuild] [--verify]\n");
+            return 2;
+        }
+    }
+
+    int failures = 0;
+    for (int len=4; len<=6; ++len) {
+        Dictionary words = Dictionary::load(wordsPath, len);
+        if (words.empty()) { std::printf("len %d: no words\n", len); continue; }
+
+        auto t0 = std::chrono::steady_clock::now();
+        PatternMatrix m;
+        if (rebuild) {
+            m.build(words, threads);
+            m.save(PatternMatrix::cachePath(wordsPath, len));
+        } else {
+            m = PatternMatrix::loadOrBuild(wordsPath, words, threads);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::printf("len %d: %zu words, %zu cells x %d B, %s in %.1f ms -> %s\n",
+            len, m.size(), m.size() * m.size(), m.cellBytes(),
+            m.mapped() ? "mapped" : "built", ms,
+            PatternMatrix::cachePath(wordsPath, len).c_str());
+
+        if (verify) {
+            for (size_t g=0; g<m.size(); ++g)
+                for (size_t a=0; a<m.size(); ++a)
+                    failures += referenceScore(words[a], words[g]) != m.at(g, a);
+        }
+    }
+    if (verify) std::printf("verify: %d mismatches\n", failures);
+    return failures ? 1 : 0;
+}
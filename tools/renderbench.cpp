@@ -0,0 +1,203 @@
+// cipher-renderbench: draws scripted Game states into an offscreen
+// sf::RenderTexture through ImGui-SFML (no window, so it runs headless
+// under a software GL, e.g. `xvfb-run` with LIBGL_ALWAYS_SOFTWARE=1),
+// times renderUI() and the whole frame over many frames, and compares a
+// hash of each state's pixels with a golden PNG.
+//
+//   cipher-renderbench [--frames N] [--size WxH] [--golden DIR] [--update]
+//
+// --update rewrites the goldens instead of checking them. A mismatch saves
+// the frame as DIR/<state>.actual.png next to the golden. Goldens are only
+// comparable on the GL implementation that wrote them. A state without a
+// golden fails the run like a mismatch does.
+#include "Game.hpp"
+#include <SFML/Graphics.hpp>
+#include <imgui-SFML.h>
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        int frames = 5000;
+        unsigned width = 1000, height = 800;
+        std::string golden = "assets/golden";
+        bool update = false;
+    };
+
+    // frames drawn before the capture: ImGui sizes auto-fit windows over
+    // the first couple of frames
+    constexpr int kSettleFrames = 4;
+
+    void usage() {
+        std::fprintf(stderr, "usage: cipher-renderbench [--frames N] [--size WxH] [--golden DIR] [--update]\n");
+    }
+
+    double percentile(std::vector<double> v, double q) {
+        if (v.empty()) return 0.0;
+        size_t k = std::min(v.size() - 1, (size_t)(q * v.size()));
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+        return v[k];
+    }
+
+    uint64_t pixelHash(const sf::Image& img) {
+        uint64_t h = 1469598103934665603ull;
+        const sf::Uint8* p = img.getPixelsPtr();
+        const size_t n = (size_t)img.getSize().x * img.getSize().y * 4;
+        for (size_t i=0; i<n; ++i) { h ^= p[i]; h *= 1099511628211ull; }
+        return h;
+    }
+
+    void typeWord(Game& game, std::string_view w) {
+        for (char c : w) game.onTextEntered((sf::Uint32)(unsigned char)c);
+    }
+
+    // Submits `n` dictionary words that are not board 0's secret.
+    void guessWrong(Game& game, int n) {
+        const GameState& core = game.core();
+        const Dictionary& dict = core.dictionary();
+        for (size_t i=0; n > 0 && i < dict.size(); ++i) {
+            if (dict[i] == core.secret()) continue;
+            typeWord(game, dict[i]);
+            game.onKeyPressed(sf::Keyboard::Enter);
+            --n;
+        }
+    }
+
+    // Lets flips and key fades finish so the capture does not depend on
+    // frame timing.
+    void settle(Game& game) {
+        for (int i=0; i<8; ++i) game.update(0.25f);
+    }
+
+    struct Scene {
+        const char* name;
+        void (*script)(Game& game);
+    };
+
+    const Scene kScenes[] = {
+        {"empty", [](Game& g) { g.newGame(GameConfig{}); }},
+        {"midgame", [](Game& g) {
+            g.newGame(GameConfig{});
+            guessWrong(g, 3);
+            typeWord(g, g.core().dictionary()[0].substr(0, 2));
+        }},
+        {"win", [](Game& g) {
+            g.newGame(GameConfig{});
+            guessWrong(g, 2);
+            typeWord(g, g.core().secret());
+            g.onKeyPressed(sf::Keyboard::Enter);
+        }},
+        {"six8", [](Game& g) {
+            GameConfig cfg;
+            cfg.length = 6;
+            cfg.attempts = 8;
+            g.newGame(cfg);
+            guessWrong(g, 7);
+        }},
+    };
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--frames") opt.frames = std::max(1, std::atoi(next()));
+        else if (a == "--size") {
+            if (std::sscanf(next(), "%ux%u", &opt.width, &opt.height) != 2) { usage(); return 2; }
+        }
+        else if (a == "--golden") opt.golden = next();
+        else if (a == "--update") opt.update = true;
+        else { usage(); return 2; }
+    }
+
+    // ImGui-SFML keys its context on an sf::Window; this one is never opened
+    sf::Window imguiWindow;
+    sf::RenderTexture target;
+    if (!target.create(opt.width, opt.height)) { std::fprintf(stderr, "cannot create render texture\n"); return 1; }
+    if (!ImGui::SFML::Init(imguiWindow, target)) { std::fprintf(stderr, "cannot create ImGui font texture\n"); return 1; }
+    ImGui::GetIO().IniFilename = nullptr; // window placement must not leak between runs
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.FrameRounding = 8.f;
+    style.ScrollbarRounding = 8.f;
+    style.WindowRounding = 8.f;
+
+    const sf::Vector2f size((float)opt.width, (float)opt.height);
+    const float dt = 1.f / 60.f;
+    using clock = std::chrono::steady_clock;
+    // returns the renderUI() time; the mouse is parked off-screen so nothing is hovered
+    auto frame = [&](Game& game) {
+        ImGui::SFML::Update(sf::Vector2i(-10000, -10000), size, sf::seconds(dt));
+        auto t0 = clock::now();
+        game.renderUI();
+        double ms = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        target.clear(sf::Color(20, 20, 26));
+        ImGui::SFML::Render(target);
+        target.display();
+        return ms;
+    };
+
+    if (opt.update) std::filesystem::create_directories(opt.golden);
+    std::printf("%-8s %9s %9s %9s %9s %9s  %-16s %s\n", "state", "ui p50", "ui p99", "ui max", "frame p50",
+                "frame p99", "pixels", "golden");
+    int failures = 0;
+    for (const Scene& scene : kScenes) {
+        Game game(2025);
+        game.setDailySeed(1);
+        scene.script(game);
+        settle(game);
+
+        for (int i=0; i<kSettleFrames; ++i) frame(game);
+        sf::Image shot = target.getTexture().copyToImage();
+        const uint64_t hash = pixelHash(shot);
+
+        // game.update() is not called, so every timed frame draws the same board
+        std::vector<double> uiMs, frameMs;
+        uiMs.reserve(opt.frames);
+        frameMs.reserve(opt.frames);
+        for (int i=0; i<opt.frames; ++i) {
+            auto t0 = clock::now();
+            uiMs.push_back(frame(game));
+            frameMs.push_back(std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+        }
+
+        const std::string path = opt.golden + "/" + scene.name + ".png";
+        const char* verdict = "match";
+        bool failed = false;
+        sf::Image golden;
+        if (opt.update) {
+            failed = !shot.saveToFile(path);
+            verdict = failed ? "WRITE FAILED" : "written";
+        } else if (!std::filesystem::exists(path)) {
+            failed = true;
+            verdict = "MISSING (run with --update)";
+        } else if (!golden.loadFromFile(path)) {
+            failed = true;
+            verdict = "UNREADABLE";
+        } else if (golden.getSize() != shot.getSize()) {
+            failed = true;
+            verdict = "SIZE MISMATCH";
+        } else if (pixelHash(golden) != hash) {
+            failed = true;
+            verdict = "MISMATCH";
+            shot.saveToFile(opt.golden + "/" + scene.name + ".actual.png");
+        }
+        failures += failed;
+
+        std::printf("%-8s %9.4f %9.4f %9.4f %9.4f %9.4f  %016llx %s\n", scene.name, percentile(uiMs, 0.50),
+                    percentile(uiMs, 0.99), *std::max_element(uiMs.begin(), uiMs.end()),
+                    percentile(frameMs, 0.50), percentile(frameMs, 0.99), (unsigned long long)hash, verdict);
+    }
+    ImGui::SFML::Shutdown();
+    std::printf("(ms over %d frames at %ux%u)\n", opt.frames, opt.width, opt.height);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+// cipher-replay: feeds a log written by `cipher --record PATH` back into a
+// Game as fast as possible, checks the final board against the recording
+// and reports per-frame timings.
+//
+// Without --offscreen no window or ImGui context exists and only the game
+// logic runs; with it every frame is also drawn into an sf::RenderTexture.
+// Heap allocations made by input events and frames after the warm-up are
+// counted too; --no-alloc turns any into a failure.
+#include "FrameProfiler.hpp"
+#include "Game.hpp"
+#include "InputLog.hpp"
+#include <SFML/Graphics.hpp>
+#include <imgui-SFML.h>
+#include <imgui.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string log;
+        bool offscreen = false;
+        unsigned width = 1000, height = 800;
+        std::string csv;     // per-frame timings
+        bool noAlloc = false; // fail if warm events/frames allocate
+    };
+
+    // frames before allocations count: ImGui and the layout caches fill up
+    constexpr size_t kWarmFrames = 120;
+
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-replay LOG [--offscreen] [--size WxH] [--csv PATH] [--no-alloc]\n");
+    }
+
+    double percentile(std::vector<double> v, double q) {
+        if (v.empty()) return 0.0;
+        size_t k = std::min(v.size() - 1, (size_t)(q * v.size()));
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+        return v[k];
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--offscreen") opt.offscreen = true;
+        else if (a == "--size") {
+            if (std::sscanf(next(), "%ux%u", &opt.width, &opt.height) != 2) { usage(); return 2; }
+        }
+        else if (a == "--csv") opt.csv = next();
+        else if (a == "--no-alloc") opt.noAlloc = true;
+        else if (!a.empty() && a[0] == '-') { usage(); return 2; }
+        else opt.log = a;
+    }
+    if (opt.log.empty()) { usage(); return 2; }
+
+    InputLog::Contents log = InputLog::read(opt.log);
+    if (!log.error.empty() && log.records.empty()) {
+        std::fprintf(stderr, "%s\n", log.error.c_str());
+        return 2;
+    }
+    if (!log.error.empty()) std::fprintf(stderr, "warning: %s, replaying what was read\n", log.error.c_str());
+
+    Game game(log.seed);
+    game.setDailySeed(log.dailySeed);
+
+    // ImGui-SFML keys its context on an sf::Window; this one is never opened
+    sf::Window imguiWindow;
+    std::unique_ptr<sf::RenderTexture> target;
+    if (opt.offscreen) {
+        target = std::make_unique<sf::RenderTexture>();
+        if (!target->create(opt.width, opt.height)) { std::fprintf(stderr, "cannot create render texture\n"); return 1; }
+        if (!ImGui::SFML::Init(imguiWindow, *target)) { std::fprintf(stderr, "cannot create ImGui font texture\n"); return 1; }
+        ImGuiStyle& style = ImGui::GetStyle();
+        style.FrameRounding = 8.f;
+        style.ScrollbarRounding = 8.f;
+        style.WindowRounding = 8.f;
+    }
+
+    std::vector<double> frameMs;
+    frameMs.reserve(log.frames);
+    uint64_t expected = 0;
+    bool haveExpected = false;
+
+    // events and frames; menu actions may resize buffers and are not counted
+    uint64_t eventAllocs = 0, frameAllocs = 0;
+    size_t events = 0, warmFrames = 0;
+
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+    auto frameStart = t0;
+    for (const InputLog::Record& r : log.records) {
+        const uint64_t allocsBefore = FrameProfiler::allocations();
+        const bool warm = frameMs.size() >= kWarmFrames;
+        switch (r.op) {
+        case InputLog::Op::Text: game.onTextEntered((sf::Uint32)r.value); break;
+        case InputLog::Op::Key: game.onKeyPressed((sf::Keyboard::Key)r.value); break;
+        case InputLog::Op::NewGame: game.newGame(r.cfg); break;
+        case InputLog::Op::Restart: game.restart(); break;
+        case InputLog::Op::Lenient: game.setLenient(r.value != 0); break;
+        case InputLog::Op::End: expected = r.hash; haveExpected = true; break;
+        case InputLog::Op::Frame:
+            game.update(r.dt);
+            if (target) {
+                // mouse parked off-screen so nothing is hovered
+                ImGui::SFML::Update(sf::Vector2i(-10000, -10000), sf::Vector2f((float)opt.width, (float)opt.height),
+                                    sf::seconds(r.dt));
+                game.renderUI();
+                target->clear(sf::Color(20, 20, 26));
+                ImGui::SFML::Render(*target);
+                target->display();
+            }
+            auto now = clock::now();
+            frameMs.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+            frameStart = now;
+            break;
+        }
+        const uint64_t allocs = FrameProfiler::allocations() - allocsBefore;
+        if (!warm) continue;
+        if (r.op == InputLog::Op::Frame) { frameAllocs += allocs; ++warmFrames; }
+        else if (r.op == InputLog::Op::Text || r.op == InputLog::Op::Key) { eventAllocs += allocs; ++events; }
+    }
+    double secs = std::chrono::duration<double>(clock::now() - t0).count();
+    if (target) ImGui::SFML::Shutdown();
+
+    uint64_t got = game.stateHash();
+    double sum = 0.0, worst = 0.0;
+    for (double ms : frameMs) { sum += ms; worst = std::max(worst, ms); }
+    std::printf("replayed %zu frames (%zu records) in %.3f s%s\n", frameMs.size(), log.records.size(), secs,
+                opt.offscreen ? ", offscreen rendering" : ", logic only");
+    if (!frameMs.empty()) {
+        std::printf("frame ms: mean %.4f  p50 %.4f  p99 %.4f  max %.4f\n", sum / frameMs.size(),
+                    percentile(frameMs, 0.50), percentile(frameMs, 0.99), worst);
+    }
+
+    std::printf("allocations after %zu warm-up frames: %llu in %zu events, %llu in %zu frames\n", kWarmFrames,
+                (unsigned long long)eventAllocs, events, (unsigned long long)frameAllocs, warmFrames);
+    const bool allocFail = opt.noAlloc && (eventAllocs || frameAllocs);
+
+    if (!opt.csv.empty()) {
+        std::FILE* f = std::fopen(opt.csv.c_str(), "w");
+        if (!f) { std::fprintf(stderr, "cannot write %s\n", opt.csv.c_str()); return 1; }
+        std::fprintf(f, "frame,ms\n");
+        for (size_t i=0;i<frameMs.size();++i) std::fprintf(f, "%zu,%.4f\n", i, frameMs[i]);
+        std::fclose(f);
+    }
+
+    if (!haveExpected) {
+        std::printf("state %016llx (log has no final hash to compare)\n", (unsigned long long)got);
+        return allocFail ? 1 : 0;
+    }
+    bool ok = got == expected;
+    std::printf("state %016llx, recorded %016llx: %s\n", (unsigned long long)got,
+                (unsigned long long)expected, ok ? "match" : "MISMATCH");
+    return ok && !allocFail ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+// cipher-server: hosts independent games for many clients at once over
+// loopback TCP and/or a Unix socket (see Protocol.hpp). Ctrl-C stops it.
+#include "GameServer.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+    GameServer* g_server = nullptr;
+
+    void onSignal(int) {
+        if (g_server) g_server->stop();
+    }
+
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-server [--host ADDR] [--port N] [--no-tcp] [--unix PATH]\n"
+            "                     [--threads N] [--words PATH] [--seed N]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    GameServer::Options opt;
+    opt.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--host") opt.host = next();
+        else if (a == "--port") opt.port = std::atoi(next());
+        else if (a == "--no-tcp") opt.port = -1;
+        else if (a == "--unix") opt.unixPath = next();
+        else if (a == "--threads") opt.threads = std::atoi(next());
+        else if (a == "--words") opt.wordsPath = next();
+        else if (a == "--seed") opt.seed = std::strtoull(next(), nullptr, 10);
+        else { usage(); return 2; }
+    }
+
+    GameServer server;
+    std::string error;
+    if (!server.start(opt, error)) { std::fprintf(stderr, "cipher-server: %s\n", error.c_str()); return 1; }
+    g_server = &server;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    if (server.port() >= 0) std::printf("listening on %s:%d", opt.host.c_str(), server.port());
+    if (!opt.unixPath.empty()) std::printf("%s%s", server.port() >= 0 ? " and " : "listening on ", opt.unixPath.c_str());
+    std::printf(" with %d worker%s\n", opt.threads, opt.threads == 1 ? "" : "s");
+    std::fflush(stdout);
+
+    server.run();
+    g_server = nullptr;
+
+    const GameServer::Counters& c = server.counters();
+    std::printf("served %llu connections, %llu requests, %llu finished games\n",
+        (unsigned long long)c.accepted.load(), (unsigned long long)c.requests.load(),
+        (unsigned long long)c.games.load());
+    return 0;
+}
@@ -0,0 +1,113 @@
+// cipher-solve: entropy solver over the pattern matrix. Prints the best
+// opener and the full decision tree for every supported word length.
+#include "PatternMatrix.hpp"
+#include "Solver.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+    void usage() {
+        std::fprintf(stderr,
+            "usage: cipher-solve [--words PATH] [--length N] [--depth 1|2] [--top K]\n"
+            "                    [--threads N] [--no-tree] [--tree-out PATH]\n");
+    }
+
+    void patternText(Pattern p, int len, char* out) {
+        TileState st[Patterns::kMaxLength];
+        Patterns::decode(p, len, st);
+        for (int i=0;i<len;++i)
+            out[i] = st[i] == TileState::Correct ? 'G' : (st[i] == TileState::Present ? 'Y' : '.');
+        out[len] = '\0';
+    }
+
+    void printTree(std::FILE* f, const Solver& s, const Dictionary& words,
+                   int node, int indent, int len) {
+        const Solver::Node& n = s.nodes()[node];
+        std::string_view w = words[n.guess];
+        std::fprintf(f, "%.*s (%d)\n", (int)w.size(), w.data(), n.candidates);
+        char pat[Patterns::kMaxLength + 1];
+        for (const auto& [p, child] : n.children) {
+            patternText(p, len, pat);
+            std::fprintf(f, "%*s%s ", indent + 2, "", pat);
+            printTree(f, s, words, child, indent + 2, len);
+        }
+    }
+
+    double since(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string wordsPath = "assets/words.txt";
+    std::string treeOut;
+    int onlyLen = 0, threads = 0;
+    bool tree = true;
+    Solver::Options opt;
+    for (int i=1;i<argc;++i) {
+        std::string a = argv[i];
+        auto next = [&]() -> const char* {
+            if (i+1 >= argc) { usage(); std::exit(2); }
+            return argv[++i];
+        };
+        if (a == "--words") wordsPath = next();
+        else if (a == "--length") onlyLen = std::atoi(next());
+        else if (a == "--depth") opt.depth = std::atoi(next());
+        else if (a == "--top") opt.topK = std::atoi(next());
+        else if (a == "--threads") threads = std::atoi(next());
+        else if (a == "--no-tree") tree = false;
+        else if (a == "--tree-out") treeOut = next();
+        else { usage(); return 2; }
+    }
+
+    ThreadPool pool(threads);
+    std::FILE* treeFile = stdout;
+    if (!treeOut.empty()) {
+        treeFile = std::fopen(treeOut.c_str(), "w");
+        if (!treeFile) { std::fprintf(stderr, "cannot open %s\n", treeOut.c_str()); return 1; }
+    }
+    std::printf("threads: %d, depth: %d\n", pool.size(), opt.depth);
+
+    for (int len=4; len<=6; ++len) {
+        if (onlyLen && len != onlyLen) continue;
+        Dictionary words = Dictionary::load(wordsPath, len);
+        if (words.empty()) { std::printf("\n[len %d] no words\n", len); continue; }
+
+        auto t0 = std::chrono::steady_clock::now();
+        PatternMatrix m = PatternMatrix::loadOrBuild(wordsPath, words, threads);
+        double tMatrix = since(t0);
+
+        Solver solver(words, m, pool);
+        std::vector<int> all(words.size());
+        for (size_t i=0;i<all.size();++i) all[i] = (int)i;
+
+        t0 = std::chrono::steady_clock::now();
+        Solver::Choice open = solver.best(all, opt);
+        double tOpen = since(t0);
+        uint64_t scored = solver.guessesScored();
+
+        std::printf("\n[len %d] %zu words, matrix %s in %.2f s\n", len, words.size(),
+            m.mapped() ? "mapped" : "built", tMatrix);
+        std::string_view ow = words[open.guess];
+        std::printf("opener: %.*s (%.3f bits) in %.3f s, %.0f guesses/s\n",
+            (int)ow.size(), ow.data(), open.score, tOpen, tOpen > 0 ? scored / tOpen : 0.0);
+
+        if (!tree) continue;
+        t0 = std::chrono::steady_clock::now();
+        int root = solver.buildTree(all, opt);
+        double tTree = since(t0);
+        uint64_t total = 0; int worst = 0;
+        solver.treeCost(root, total, worst);
+        std::printf("tree: %zu nodes in %.3f s, avg %.3f guesses, worst %d, %.0f guesses/s\n",
+            solver.nodes().size(), tTree, (double)total / words.size(), worst,
+            tTree > 0 ? (solver.guessesScored() - scored) / tTree : 0.0);
+        if (treeFile != stdout) std::fprintf(treeFile, "[len %d]\n", len);
+        printTree(treeFile, solver, words, root, 0, len);
+    }
+    if (treeFile != stdout) std::fclose(treeFile);
+    return 0;
+}